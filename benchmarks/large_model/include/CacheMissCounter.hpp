@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Last-level cache references and misses of this thread, in user
+// space, from the kernel's hardware counters. Needs Linux with
+// perf_event_paranoid <= 2 and a PMU the kernel exposes (often missing
+// in VMs and containers); otherwise isAvailable() is false and
+// getError() says why. `perf stat -e cache-references,cache-misses`
+// gives the same numbers for a whole run.
+class CacheMissCounter
+{
+public:
+	struct Counts
+	{
+		uint64_t references = 0;
+		uint64_t misses = 0;
+	};
+
+	CacheMissCounter()
+	{
+#ifdef __linux__
+		references_ = open(PERF_COUNT_HW_CACHE_REFERENCES, -1);
+		if (references_ >= 0)
+			misses_ = open(PERF_COUNT_HW_CACHE_MISSES, references_);
+		if (misses_ < 0)
+			error_ = std::strerror(errno);
+#else
+		error_ = "needs Linux perf_event_open()";
+#endif
+	}
+
+	~CacheMissCounter()
+	{
+#ifdef __linux__
+		if (misses_ >= 0)
+			close(misses_);
+		if (references_ >= 0)
+			close(references_);
+#endif
+	}
+
+	CacheMissCounter(const CacheMissCounter &) = delete;
+	CacheMissCounter &operator=(const CacheMissCounter &) = delete;
+
+	bool isAvailable() const { return misses_ >= 0; }
+	const std::string &getError() const { return error_; }
+
+	void start()
+	{
+#ifdef __linux__
+		if (!isAvailable())
+			return;
+		ioctl(references_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(references_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+	}
+
+	Counts stop()
+	{
+		Counts counts;
+#ifdef __linux__
+		if (!isAvailable())
+			return counts;
+		ioctl(references_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		// PERF_FORMAT_GROUP: the number of counters, then their values
+		uint64_t values[3] = {};
+		if (read(references_, values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)))
+		{
+			counts.references = values[1];
+			counts.misses = values[2];
+		}
+#endif
+		return counts;
+	}
+
+private:
+#ifdef __linux__
+	static int open(uint64_t config, int group)
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = config;
+		attr.disabled = group < 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP;
+		return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+	}
+#endif
+
+	int references_ = -1;
+	int misses_ = -1;
+	std::string error_;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <SimuCore/Component.hpp>
+#include <SimuCore/Signal.hpp>
+#include <SimuCore/Binding.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One stage of a synthetic plant: a handful of mixed-type signals
+// with some arithmetic in between, chained to the next stage.
+class Stage : public Component
+{
+public:
+	Stage(Component *parent, const std::string &name) : Component(parent, name)
+	{
+	}
+	void init() override
+	{
+	}
+	void execute() override
+	{
+		double x = a.getValue() * 0.5 + b.getValue();
+		out_a.setValue(x);
+		out_b.setValue(x - a.getValue());
+		out_count.setValue(count.getValue() + 1);
+		out_enable.setValue(enable.getValue() && x > 0.0);
+	}
+
+	InputSignal<double> a{this, "a", 1.0};
+	InputSignal<double> b{this, "b", 2.0};
+	InputSignal<int> count{this, "count"};
+	InputSignal<bool> enable{this, "enable", true};
+	OutputSignal<double> out_a{this, "out_a"};
+	OutputSignal<double> out_b{this, "out_b"};
+	OutputSignal<int> out_count{this, "out_count"};
+	OutputSignal<bool> out_enable{this, "out_enable"};
+};
+
+class LargeModel : public Component
+{
+public:
+	static constexpr int signalsPerStage = 8;
+
+	LargeModel(int number_of_stages) : Component(nullptr, "LargeModel")
+	{
+		stages_.reserve(number_of_stages);
+		for (int i = 0; i < number_of_stages; ++i)
+			stages_.push_back(std::make_unique<Stage>(this, "Stage" + std::to_string(i)));
+
+		for (int i = 0; i + 1 < number_of_stages; ++i)
+		{
+			ComponentBinder::bind(stages_[i]->out_a, stages_[i + 1]->a);
+			ComponentBinder::bind(stages_[i]->out_b, stages_[i + 1]->b);
+			ComponentBinder::bind(stages_[i]->out_count, stages_[i + 1]->count);
+			ComponentBinder::bind(stages_[i]->out_enable, stages_[i + 1]->enable);
+		}
+	}
+	void init() override
+	{
+	}
+	void execute() override
+	{
+	}
+
+private:
+	std::vector<std::unique_ptr<Stage>> stages_;
+};
@@ -0,0 +1,119 @@
+#include <CacheMissCounter.hpp>
+#include <LargeModel.hpp>
+#include <SimuCore/SignalStore.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+constexpr int numberOfStages = 6250; // 50k signals
+constexpr int numberOfTicks = 200;
+
+// Cache misses per tick are only printed where the counters are available
+CacheMissCounter cacheCounter;
+
+template <typename F>
+double measureNsPerTick(F &&f, CacheMissCounter::Counts *counts = nullptr)
+{
+	if (counts)
+		cacheCounter.start();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < numberOfTicks; ++i)
+		f();
+	auto stop = std::chrono::steady_clock::now();
+	if (counts)
+		*counts = cacheCounter.stop();
+	return std::chrono::duration<double, std::nano>(stop - start).count() / numberOfTicks;
+}
+
+void printCacheMisses(const char *label, const CacheMissCounter::Counts &counts)
+{
+	std::printf("%-19s%10.0f misses/tick, %10.0f references/tick\n", label,
+				static_cast<double>(counts.misses) / numberOfTicks, static_cast<double>(counts.references) / numberOfTicks);
+}
+}
+
+void setup()
+{
+	LargeModel model(numberOfStages);
+	model.initAll();
+
+	auto &registry = SignalRegistry::getInstance();
+	auto signals = registry.getAllSignals();
+	const PropagationPlan &plan = registry.compilePropagationPlan();
+
+	CacheMissCounter::Counts execute_cache, double_buffered_cache, reset_cache;
+	double execute = measureNsPerTick([&]
+									  {
+		model.executeAll();
+		registry.endTick(); }, &execute_cache);
+
+	registry.setDoubleBuffered(true);
+	double double_buffered = measureNsPerTick([&]
+											  {
+		model.executeAll();
+		registry.endTick(); }, &double_buffered_cache);
+	registry.setDoubleBuffered(false);
+
+	model.executeAll();
+	volatile std::size_t changed = 0;
+	double telemetry = measureNsPerTick([&]
+										{
+		for (auto index : registry.getChangedSignals())
+			changed += registry.getSignalByIndex(index) != nullptr; });
+
+	// Lookups by ID, as the protocol handlers do them
+	std::vector<ComponentId> ids;
+	for (auto *signal : signals)
+		ids.push_back(signal->getId());
+	volatile std::size_t found = 0;
+	auto lookupAll = [&]
+	{
+		for (auto id : ids)
+			found += registry.find(id) != nullptr;
+	};
+	double hashed_lookup = measureNsPerTick(lookupAll) / ids.size();
+	registry.freeze(&model);
+	double frozen_lookup = measureNsPerTick(lookupAll) / ids.size();
+
+	// Freezing captures the state that reset_signals() restores
+	double reset = measureNsPerTick([&]
+									{ registry.reset_signals(); }, &reset_cache);
+
+#ifdef SIMUCORE_POOLED_SIGNALS
+	const char *storage = "pooled";
+#else
+	const char *storage = "inline";
+#endif
+	std::printf("storage:           %s\n", storage);
+	std::printf("signals:           %zu\n", signals.size());
+	std::printf("plan:              %zu outputs, %zu bound inputs\n", plan.routeCount(), plan.destinationCount());
+	std::printf("execute:           %10.0f ns/tick\n", execute);
+	std::printf("double-buffered:   %10.0f ns/tick\n", double_buffered);
+	std::printf("change scan:       %10.0f ns/tick\n", telemetry);
+	std::printf("reset:             %10.0f ns/reset\n", reset);
+	std::printf("find (hash map):   %10.1f ns/lookup\n", hashed_lookup);
+	std::printf("find (frozen):     %10.1f ns/lookup\n", frozen_lookup);
+	if (cacheCounter.isAvailable())
+	{
+		printCacheMisses("execute (LLC):", execute_cache);
+		printCacheMisses("double-b. (LLC):", double_buffered_cache);
+		printCacheMisses("reset (LLC):", reset_cache);
+	}
+	else
+		std::printf("cache misses:      unavailable (%s), try perf stat\n", cacheCounter.getError().c_str());
+	for (auto *pool : SignalStore::getInstance().getPools())
+		std::printf("pool:              %zu slots x %zu bytes\n", pool->size(), pool->bytesPerSlot());
+	// Hot: what the tick loop walks; cold: names, tree links and bindings
+	std::printf("memory (hot):      %10zu bytes/signal in signal objects\n",
+				(sizeof(Stage) - sizeof(Component)) / LargeModel::signalsPerStage);
+	std::printf("memory (cold):     %10zu bytes/signal in the ComponentTable\n",
+				ComponentTable::getInstance().memoryUsage() / signals.size());
+	std::exit(0);
+}
+
+void loop()
+{
+}
@@ -2,13 +2,24 @@
 #include <SimuCore/Signal.hpp>
 #include <SimuCore/SimuCoreLogger.hpp>
 
+enum class BindingMode
+{
+	// The output copies every new value into the input
+	Copy,
+	// The input reads the output's value in place, no copy per tick
+	Alias
+};
+
 class ComponentBinder
 {
 public:
 	template <typename T>
-	static void bind(OutputSignal<T> &output, InputSignal<T> &input)
+	static void bind(OutputSignal<T> &output, InputSignal<T> &input, BindingMode mode = BindingMode::Copy)
 	{
-		output.connectTo(&input);
+		if (mode == BindingMode::Alias)
+			output.aliasTo(&input);
+		else
+			output.connectTo(&input);
 		SimuCoreLogger::log("Bound " + output.getFullName() + "to " + input.getFullName());
 	}
 };
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// ------------------------------------------------------------
+// Signal buses
+//
+// A bus is a plain struct that lists its fields once, in a static
+// fields() function:
+//
+//   struct DriveBus
+//   {
+//       double speed = 0;
+//       double torque = 0;
+//
+//       template <typename F>
+//       static void fields(F &&field)
+//       {
+//           field("speed", &DriveBus::speed);
+//           field("torque", &DriveBus::torque);
+//       }
+//   };
+//
+// OutputSignal<DriveBus> and InputSignal<DriveBus> are bound with a
+// single ComponentBinder::bind() call and the whole struct travels
+// along that one edge as a single copy. Every field is also
+// registered as a signal of its own, nested under the bus in the
+// ApplicationTree, with its own ID and change tracking.
+// ------------------------------------------------------------
+struct BusFieldProbe
+{
+	template <typename S, typename T>
+	void operator()(const char *, T S::*) const {}
+};
+
+template <typename T, typename = void>
+struct IsBus : std::false_type
+{
+};
+
+template <typename T>
+struct IsBus<T, std::void_t<decltype(T::fields(std::declval<BusFieldProbe &>()))>> : std::true_type
+{
+};
+
+template <typename T>
+constexpr bool isBus = IsBus<T>::value;
+
+// Calls f(index, name, member pointer) for every field, in declaration order
+template <typename S, typename F>
+void forEachBusField(F &&f)
+{
+	std::size_t index = 0;
+	S::fields([&](const char *name, auto member)
+			  { f(index++, name, member); });
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------------
+// Tick at which each signal last changed, plus an intrusive list
+// of all signals ordered by that tick (oldest first). Stamps only
+// ever grow, so restamping a signal moves it to the newest end and
+// "what changed since tick N" walks back from there, visiting the
+// changed signals and nothing else.
+//
+// Entries are written with release stores and read with acquire
+// loads, as SeqLock requires, so network threads can walk the index
+// inside a SignalSnapshot read section.
+// ------------------------------------------------------------
+class ChangeIndex
+{
+public:
+	static constexpr uint32_t none = UINT32_MAX;
+
+	// Appends the next index, stamped with tick. Not safe next to readers:
+	// SignalRegistry stops adding once snapshots are enabled
+	void add(uint64_t tick)
+	{
+		uint32_t index = static_cast<uint32_t>(stamps_.size());
+		stamps_.push_back(tick);
+		older_.push_back(none);
+		newer_.push_back(none);
+		link(index);
+	}
+
+	void stamp(uint32_t index, uint64_t tick)
+	{
+		store(stamps_[index], tick);
+		if (index == newest_)
+			return;
+		unlink(index);
+		link(index);
+	}
+
+	uint64_t lastChanged(uint32_t index) const { return load(stamps_[index]); }
+
+	// Calls f(index) for every index stamped at or after tick, newest
+	// first. A walk racing with stamp() may see a half-moved entry; it
+	// is bounded by the entry count and the caller retries it.
+	template <typename F>
+	void forEachSince(uint64_t tick, F &&f) const
+	{
+		std::size_t steps = stamps_.size();
+		for (uint32_t index = load(newest_); index != none && steps-- && load(stamps_[index]) >= tick; index = load(older_[index]))
+			f(index);
+	}
+
+	// Restamps every index without reordering them
+	void restampAll(uint64_t tick)
+	{
+		for (auto &stamp : stamps_)
+			store(stamp, tick);
+	}
+
+private:
+	template <typename T>
+	static T load(const T &entry) { return __atomic_load_n(&entry, __ATOMIC_ACQUIRE); }
+	template <typename T>
+	static void store(T &entry, T value) { __atomic_store_n(&entry, value, __ATOMIC_RELEASE); }
+
+	void link(uint32_t index)
+	{
+		store(older_[index], newest_);
+		store(newer_[index], none);
+		if (newest_ != none)
+			store(newer_[newest_], index);
+		store(newest_, index);
+	}
+
+	void unlink(uint32_t index)
+	{
+		if (older_[index] != none)
+			store(newer_[older_[index]], newer_[index]);
+		if (newer_[index] != none)
+			store(older_[newer_[index]], older_[index]);
+		else
+			store(newest_, older_[index]);
+	}
+
+	std::vector<uint64_t> stamps_;
+	std::vector<uint32_t> older_;
+	std::vector<uint32_t> newer_;
+	uint32_t newest_ = none;
+};
@@ -5,11 +5,59 @@
 #include <memory>
 #include <iostream>
 #include <cstdint>
+#include <string_view>
 #include <SimuCore/SimuCoreLogger.hpp>
+#include <SimuCore/ComponentTable.hpp>
+#include <SimuCore/Span.hpp>
 
 class SignalBase;
 
-enum class ComponentType
+// ------------------------------------------------------------
+// Component IDs
+//
+// 64-bit FNV-1a over the full path ("App->Motor->Speed"), computed
+// incrementally from the parent's ID so no path string is built.
+// The result is the same on every toolchain and can be computed at
+// compile time with componentIdFromPath().
+// ------------------------------------------------------------
+using ComponentId = uint64_t;
+
+constexpr ComponentId fnv1aOffsetBasis = 0xcbf29ce484222325ull;
+constexpr ComponentId fnv1aPrime = 0x100000001b3ull;
+
+constexpr ComponentId fnv1aAppend(ComponentId hash, std::string_view data)
+{
+	for (char c : data)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= fnv1aPrime;
+	}
+	return hash;
+}
+
+constexpr ComponentId childComponentId(ComponentId parent_id, std::string_view name)
+{
+	ComponentId hash = parent_id == 0 ? fnv1aAppend(fnv1aOffsetBasis, name)
+									  : fnv1aAppend(fnv1aAppend(parent_id, "->"), name);
+	// Reserve 0 for "invalid"/"no parent"
+	return hash == 0 ? 1 : hash;
+}
+
+constexpr ComponentId componentIdFromPath(std::string_view path)
+{
+	ComponentId id = 0;
+	std::size_t start = 0;
+	while (true)
+	{
+		std::size_t end = path.find("->", start);
+		id = childComponentId(id, path.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+		if (end == std::string_view::npos)
+			return id;
+		start = end + 2;
+	}
+}
+
+enum class ComponentType : uint8_t
 {
 	INTERNAL_INPUT,
 	INTERNAL_OUTPUT,
@@ -19,60 +67,66 @@ enum class ComponentType
 	COMPONENT
 };
 
+constexpr std::size_t componentTypeCount = static_cast<std::size_t>(ComponentType::COMPONENT) + 1;
+
 class Component
 {
 private:
-	uint32_t id_;
-
-	int generateDeterministicId()
-	{
-		std::string full_path = this->getFullName();
-		std::hash<std::string> hasher;
-		int hash = static_cast<uint32_t>(hasher(full_path));
-
-		// Ensure ID is never 0 (reserve 0 for "invalid")
-		return hash == 0 ? 1 : hash;
-	}
+	ComponentId id_;
+	// Name, parent, subcomponents and bindings live in the ComponentTable
+	uint32_t slot_;
+#ifdef SIMUCORE_MULTI_INSTANCE
+	// The table of the context the component was built in, so that its
+	// metadata is found whichever context is active when it is read
+	ComponentTable *table_;
+#endif
 
 protected:
-	std::string name_;
 	ComponentType componentType_;
-	std::vector<Component *> subcomponents_;
-	Component *parent_;
+
+#ifdef SIMUCORE_MULTI_INSTANCE
+	ComponentTable &getTable() const { return *table_; }
+#else
+	ComponentTable &getTable() const { return ComponentTable::getInstance(); }
+#endif
+	ComponentInfo &getInfo() const { return getTable().get(slot_); }
 
 public:
-	Component(Component *parent, const std::string &name, ComponentType componentType = ComponentType::COMPONENT) : name_(name), parent_(parent), componentType_(componentType)
+	Component(Component *parent, const std::string &name, ComponentType componentType = ComponentType::COMPONENT) : componentType_(componentType)
 	{
+#ifdef SIMUCORE_MULTI_INSTANCE
+		table_ = &ComponentTable::getInstance();
+#endif
+		slot_ = getTable().add(name, parent);
 		if (parent)
 		{
-			parent->subcomponents_.push_back(this);
+			parent->getTable().addSubComponent(parent->slot_, this);
 		}
-		id_ = generateDeterministicId();
+		id_ = childComponentId(parent ? parent->id_ : 0, name);
 	}
 
+	virtual ~Component() = default;
+
 	virtual void init() = 0;
 	virtual void execute() = 0;
 	std::string getFullName() const
 	{
-		if (parent_)
+		const ComponentInfo &info = getInfo();
+		if (info.parent)
 		{
-			return parent_->getFullName() + "->" + name_;
+			return info.parent->getFullName() + "->" + info.name;
 		}
-		return name_;
+		return info.name;
 	}
-	std::string getName()
+	std::string getName() const
 	{
-		return name_;
+		return getInfo().name;
 	}
 	void initAll()
 	{
-		init();
-		for (auto *sub : subcomponents_)
-		{
-			sub->initAll();
-		}
+		initAll(getTable());
 	}
-	uint32_t getId() const
+	ComponentId getId() const
 	{
 		return id_;
 	}
@@ -101,16 +155,32 @@ public:
 	}
 	void executeAll()
 	{
-		execute();
+		executeAll(getTable());
+	}
+	// Valid until the next subcomponent is added
+	Span<Component *const> getSubComponents() const
+	{
+		return getTable().getSubComponents(slot_);
+	}
 
-		// Execute all subcomponents
-		for (auto *sub : subcomponents_)
+private:
+	// The walks look the table up once, not once per component
+	void initAll(const ComponentTable &table)
+	{
+		init();
+		for (auto *sub : table.getSubComponents(slot_))
 		{
-			sub->executeAll();
+			sub->initAll(table);
 		}
 	}
-	std::vector<Component *> getSubComponents() const
+	void executeAll(const ComponentTable &table)
 	{
-		return subcomponents_;
+		execute();
+
+		// Execute all subcomponents
+		for (auto *sub : table.getSubComponents(slot_))
+		{
+			sub->executeAll(table);
+		}
 	}
 };
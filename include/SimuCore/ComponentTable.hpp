@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SimuCore/SimuCoreContext.hpp>
+#include <SimuCore/Span.hpp>
+
+class Component;
+class SignalBase;
+
+// ------------------------------------------------------------
+// Cold component metadata
+//
+// Names, tree links and bindings are only needed to build the
+// application tree, log and bind, so they live in this side table
+// instead of in the components. The objects the tick loop touches
+// (signals above all) then hold little more than their values.
+// Each component keeps its dense slot in the table. The subcomponent
+// lists sit in an array of their own, so the tick walk reads only
+// those and not the rest of the metadata.
+// ------------------------------------------------------------
+struct ComponentInfo
+{
+	std::string name;
+	Component *parent = nullptr;
+	// Signals only: the inputs bound to this output, in binding order
+	std::vector<SignalBase *> bindings;
+};
+
+class ComponentTable
+{
+public:
+	static ComponentTable &getInstance() { return SimuCoreContext::active<ComponentTable>(); }
+
+	// Returns the new entry's slot
+	uint32_t add(const std::string &name, Component *parent)
+	{
+		infos_.push_back(ComponentInfo{name, parent, {}});
+		subcomponents_.emplace_back();
+		return static_cast<uint32_t>(infos_.size() - 1);
+	}
+
+	// Valid until the next subcomponent is added
+	Span<Component *const> getSubComponents(uint32_t slot) const { return subcomponents_[slot]; }
+	void addSubComponent(uint32_t slot, Component *component) { subcomponents_[slot].push_back(component); }
+
+	ComponentInfo &get(uint32_t slot) { return infos_[slot]; }
+	const ComponentInfo &get(uint32_t slot) const { return infos_[slot]; }
+	std::size_t size() const { return infos_.size(); }
+
+	// Bytes held by the table, including names and lists on the heap
+	std::size_t memoryUsage() const
+	{
+		std::size_t bytes = infos_.capacity() * sizeof(ComponentInfo) +
+							subcomponents_.capacity() * sizeof(std::vector<Component *>);
+		for (const auto &info : infos_)
+		{
+			if (info.name.capacity() > std::string().capacity())
+				bytes += info.name.capacity() + 1;
+			bytes += info.bindings.capacity() * sizeof(SignalBase *);
+		}
+		for (const auto &subcomponents : subcomponents_)
+			bytes += subcomponents.capacity() * sizeof(Component *);
+		return bytes;
+	}
+
+private:
+	friend class SimuCoreContext;
+	ComponentTable() = default;
+	ComponentTable(const ComponentTable &) = delete;
+	ComponentTable &operator=(const ComponentTable &) = delete;
+
+	std::vector<ComponentInfo> infos_;
+	// Indexed by slot like infos_
+	std::vector<std::vector<Component *>> subcomponents_;
+};
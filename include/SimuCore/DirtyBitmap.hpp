@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------------
+// One bit per registered signal, set when the signal's value
+// changes. Iterating visits only the set bits, so a pass over
+// "what changed this tick" costs one word per 64 signals plus
+// the changed signals themselves.
+// ------------------------------------------------------------
+class DirtyBitmap
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator(const uint64_t *words, std::size_t word_count, std::size_t word_index)
+			: words_(words), word_count_(word_count), word_index_(word_index)
+		{
+			bits_ = word_index_ < word_count_ ? words_[word_index_] : 0;
+			skipEmptyWords();
+		}
+
+		std::size_t operator*() const { return word_index_ * 64 + __builtin_ctzll(bits_); }
+
+		Iterator &operator++()
+		{
+			bits_ &= bits_ - 1;
+			skipEmptyWords();
+			return *this;
+		}
+
+		bool operator!=(const Iterator &other) const
+		{
+			return word_index_ != other.word_index_ || bits_ != other.bits_;
+		}
+
+	private:
+		void skipEmptyWords()
+		{
+			while (bits_ == 0 && word_index_ < word_count_)
+			{
+				++word_index_;
+				bits_ = word_index_ < word_count_ ? words_[word_index_] : 0;
+			}
+		}
+
+		const uint64_t *words_;
+		std::size_t word_count_;
+		std::size_t word_index_;
+		uint64_t bits_;
+	};
+
+	void resize(std::size_t bit_count) { words_.resize((bit_count + 63) / 64, 0); }
+
+	void set(std::size_t index) { words_[index >> 6] |= uint64_t{1} << (index & 63); }
+	void reset(std::size_t index) { words_[index >> 6] &= ~(uint64_t{1} << (index & 63)); }
+	bool test(std::size_t index) const { return (words_[index >> 6] >> (index & 63)) & 1; }
+
+	void clear()
+	{
+		for (auto &word : words_)
+			word = 0;
+	}
+
+	void setAll(std::size_t bit_count)
+	{
+		for (std::size_t i = 0; i < bit_count; ++i)
+			set(i);
+	}
+
+	std::size_t count() const
+	{
+		std::size_t bits = 0;
+		for (auto word : words_)
+			bits += __builtin_popcountll(word);
+		return bits;
+	}
+
+	Iterator begin() const { return Iterator(words_.data(), words_.size(), 0); }
+	Iterator end() const { return Iterator(words_.data(), words_.size(), words_.size()); }
+
+private:
+	std::vector<uint64_t> words_;
+};
@@ -0,0 +1,214 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// ------------------------------------------------------------
+// Saturating Qm.n fixed-point number: a sign bit, IntegerBits
+// integer bits and FractionalBits fractional bits, stored in the
+// smallest integer that holds them. Arithmetic and conversion to
+// and from decimal text use integers only, so it stays fast on
+// MCUs without an FPU. Results outside the range clamp to it.
+// ------------------------------------------------------------
+template <int IntegerBits, int FractionalBits>
+class FixedPoint
+{
+	static_assert(IntegerBits >= 0 && FractionalBits >= 0, "Bit counts cannot be negative");
+	static_assert(IntegerBits + FractionalBits <= 31, "Fixed-point values are limited to 32 bits");
+
+public:
+	static constexpr int integerBits = IntegerBits;
+	static constexpr int fractionalBits = FractionalBits;
+	static constexpr int totalBits = IntegerBits + FractionalBits + 1;
+
+	using Storage = std::conditional_t<totalBits <= 8, int8_t,
+									   std::conditional_t<totalBits <= 16, int16_t, int32_t>>;
+
+	static constexpr int64_t maxRaw = (int64_t(1) << (totalBits - 1)) - 1;
+	static constexpr int64_t minRaw = -(int64_t(1) << (totalBits - 1));
+	static constexpr int64_t one = int64_t(1) << FractionalBits;
+
+	constexpr FixedPoint() = default;
+	// Nearest representable value, saturated
+	constexpr explicit FixedPoint(double value) : raw_(fromDouble(value)) {}
+
+	static constexpr FixedPoint fromRaw(int64_t raw)
+	{
+		FixedPoint value;
+		value.raw_ = saturate(raw);
+		return value;
+	}
+
+	static constexpr FixedPoint max() { return fromRaw(maxRaw); }
+	static constexpr FixedPoint min() { return fromRaw(minRaw); }
+
+	constexpr Storage raw() const { return raw_; }
+	constexpr double toDouble() const { return static_cast<double>(raw_) / one; }
+	constexpr explicit operator double() const { return toDouble(); }
+
+	constexpr FixedPoint operator-() const { return fromRaw(-int64_t(raw_)); }
+	constexpr FixedPoint operator+(FixedPoint other) const { return fromRaw(int64_t(raw_) + other.raw_); }
+	constexpr FixedPoint operator-(FixedPoint other) const { return fromRaw(int64_t(raw_) - other.raw_); }
+
+	// Rounds to nearest, ties away from zero
+	constexpr FixedPoint operator*(FixedPoint other) const
+	{
+		int64_t product = int64_t(raw_) * other.raw_;
+		if constexpr (FractionalBits > 0)
+		{
+			int64_t half = int64_t(1) << (FractionalBits - 1);
+			product = product < 0 ? -((-product + half) >> FractionalBits) : (product + half) >> FractionalBits;
+		}
+		return fromRaw(product);
+	}
+
+	// Division by zero saturates towards the sign of the dividend
+	constexpr FixedPoint operator/(FixedPoint other) const
+	{
+		if (other.raw_ == 0)
+			return raw_ < 0 ? min() : max();
+		return fromRaw(int64_t(raw_) * one / other.raw_);
+	}
+
+	constexpr FixedPoint &operator+=(FixedPoint other) { return *this = *this + other; }
+	constexpr FixedPoint &operator-=(FixedPoint other) { return *this = *this - other; }
+	constexpr FixedPoint &operator*=(FixedPoint other) { return *this = *this * other; }
+	constexpr FixedPoint &operator/=(FixedPoint other) { return *this = *this / other; }
+
+	constexpr bool operator==(FixedPoint other) const { return raw_ == other.raw_; }
+	constexpr bool operator!=(FixedPoint other) const { return raw_ != other.raw_; }
+	constexpr bool operator<(FixedPoint other) const { return raw_ < other.raw_; }
+	constexpr bool operator<=(FixedPoint other) const { return raw_ <= other.raw_; }
+	constexpr bool operator>(FixedPoint other) const { return raw_ > other.raw_; }
+	constexpr bool operator>=(FixedPoint other) const { return raw_ >= other.raw_; }
+
+	// Fractional digits written by toChars(): enough for the text to
+	// read back to the same value
+	static constexpr int decimalDigits()
+	{
+		int digits = 0;
+		for (uint64_t power = 1; power <= (uint64_t(1) << (FractionalBits + 1)); power *= 10)
+			++digits;
+		return FractionalBits ? digits : 0;
+	}
+
+	// Large enough for the sign, 10 integer digits, '.' and the fraction
+	static constexpr std::size_t bufferSize = 13 + decimalDigits();
+
+	// Decimal text such as "-1.25" (no trailing zeros); returns the end
+	char *toChars(char *first, char *last) const
+	{
+		if (last - first < static_cast<std::ptrdiff_t>(bufferSize))
+			return first;
+		uint64_t magnitude = raw_ < 0 ? uint64_t(-int64_t(raw_)) : uint64_t(raw_);
+		if (raw_ < 0)
+			*first++ = '-';
+		uint64_t integer = magnitude >> FractionalBits;
+		char digits[10];
+		int count = 0;
+		do
+		{
+			digits[count++] = static_cast<char>('0' + integer % 10);
+			integer /= 10;
+		} while (integer);
+		while (count)
+			*first++ = digits[--count];
+
+		// Truncated, which reads back to the same value since the
+		// error stays below half a step
+		uint64_t fraction = magnitude & (uint64_t(one) - 1);
+		if (fraction)
+		{
+			*first++ = '.';
+			for (int i = 0; i < decimalDigits(); ++i)
+			{
+				fraction *= 10;
+				*first++ = static_cast<char>('0' + (fraction >> FractionalBits));
+				fraction &= uint64_t(one) - 1;
+			}
+			while (first[-1] == '0')
+				--first;
+		}
+		return first;
+	}
+
+	// Parses "[+-]digits[.digits]", surrounded by optional spaces.
+	// Rounds to nearest and saturates; false if the text is malformed.
+	static bool fromChars(const char *first, const char *last, FixedPoint &value)
+	{
+		while (first < last && *first == ' ')
+			++first;
+		while (last > first && last[-1] == ' ')
+			--last;
+		bool negative = first < last && *first == '-';
+		if (first < last && (*first == '-' || *first == '+'))
+			++first;
+
+		const char *integer_end = first;
+		uint64_t integer = 0;
+		// Capped well above any range, so the shifts below cannot overflow
+		constexpr uint64_t integerCap = uint64_t(1) << 31;
+		for (; integer_end < last && *integer_end >= '0' && *integer_end <= '9'; ++integer_end)
+			integer = integer >= integerCap ? integerCap : integer * 10 + uint64_t(*integer_end - '0');
+		const char *fraction_end = integer_end;
+		if (fraction_end < last && *fraction_end == '.')
+			++fraction_end;
+		const char *fraction_begin = fraction_end;
+		while (fraction_end < last && *fraction_end >= '0' && *fraction_end <= '9')
+			++fraction_end;
+		if (fraction_end != last || (integer_end == first && fraction_end == fraction_begin))
+			return false;
+
+		// Binary fraction with 60 bits, built from the last digit back
+		constexpr int guardBits = 60;
+		uint64_t fraction = 0;
+		for (const char *digit = fraction_end; digit > fraction_begin; --digit)
+			fraction = ((uint64_t(digit[-1] - '0') << guardBits) + fraction) / 10;
+		fraction = (fraction + (uint64_t(1) << (guardBits - FractionalBits - 1))) >> (guardBits - FractionalBits);
+
+		uint64_t magnitude = (std::min(integer, integerCap) << FractionalBits) + fraction;
+		value = fromRaw(negative ? -int64_t(magnitude) : int64_t(magnitude));
+		return true;
+	}
+
+private:
+	static constexpr Storage saturate(int64_t raw)
+	{
+		return static_cast<Storage>(raw > maxRaw ? maxRaw : raw < minRaw ? minRaw : raw);
+	}
+
+	// Range checked before converting, so huge values and NaN are safe
+	static constexpr Storage fromDouble(double value)
+	{
+		if (value != value)
+			return 0;
+		if (value >= double(maxRaw) / one)
+			return Storage(maxRaw);
+		if (value <= double(minRaw) / one)
+			return Storage(minRaw);
+		return saturate(static_cast<int64_t>(value * one + (value < 0 ? -0.5 : 0.5)));
+	}
+
+	Storage raw_ = 0;
+};
+
+// Q15 and Q31: no integer bits, range [-1, 1)
+using Q15 = FixedPoint<0, 15>;
+using Q31 = FixedPoint<0, 31>;
+
+// Qm.n, e.g. Q<3, 12> covers [-8, 8) in steps of 1/4096
+template <int IntegerBits, int FractionalBits>
+using Q = FixedPoint<IntegerBits, FractionalBits>;
+
+template <typename T>
+struct IsFixedPoint
+{
+	static constexpr bool value = false;
+};
+
+template <int IntegerBits, int FractionalBits>
+struct IsFixedPoint<FixedPoint<IntegerBits, FractionalBits>>
+{
+	static constexpr bool value = true;
+};
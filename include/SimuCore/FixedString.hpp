@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// ------------------------------------------------------------
+// String with inline, fixed capacity. Setting or copying it never
+// allocates, so string-typed signals stay allocation-free in the
+// tick loop. assign() keeps what fits and reports a cut; writes
+// from text (SignalConversion::fromString) refuse text that is cut.
+// ------------------------------------------------------------
+template <std::size_t N>
+class FixedString
+{
+public:
+	FixedString() = default;
+	FixedString(const char *text) { assign(std::string_view(text)); }
+	FixedString(std::string_view text) { assign(text); }
+	FixedString(const std::string &text) { assign(text); }
+
+	FixedString &operator=(std::string_view text)
+	{
+		assign(text);
+		return *this;
+	}
+
+	static constexpr std::size_t capacity() { return N; }
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	const char *c_str() const { return data_; }
+	std::string_view view() const { return std::string_view(data_, size_); }
+	std::string str() const { return std::string(data_, size_); }
+	operator std::string_view() const { return view(); }
+
+	// False if the text had to be truncated
+	bool assign(std::string_view text)
+	{
+		size_ = text.size() < N ? text.size() : N;
+		std::memcpy(data_, text.data(), size_);
+		data_[size_] = '\0';
+		return size_ == text.size();
+	}
+
+	bool operator==(const FixedString &other) const
+	{
+		return size_ == other.size_ && std::memcmp(data_, other.data_, size_) == 0;
+	}
+	bool operator!=(const FixedString &other) const { return !(*this == other); }
+
+private:
+	char data_[N + 1] = {};
+	std::size_t size_ = 0;
+};
+
+template <typename T>
+struct IsFixedString
+{
+	static constexpr bool value = false;
+};
+
+template <std::size_t N>
+struct IsFixedString<FixedString<N>>
+{
+	static constexpr bool value = true;
+};
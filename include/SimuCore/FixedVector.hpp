@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+// ------------------------------------------------------------
+// Vector with inline, fixed capacity. Used for variable-length
+// array signals without heap allocation; copies only move the
+// elements that are in use.
+// ------------------------------------------------------------
+template <typename T, std::size_t N>
+class FixedVector
+{
+public:
+	using value_type = T;
+
+	FixedVector() = default;
+	FixedVector(std::initializer_list<T> values)
+	{
+		for (const auto &value : values)
+			push_back(value);
+	}
+	FixedVector(const FixedVector &other) { *this = other; }
+
+	FixedVector &operator=(const FixedVector &other)
+	{
+		std::copy(other.data_.begin(), other.data_.begin() + other.size_, data_.begin());
+		size_ = other.size_;
+		return *this;
+	}
+
+	static constexpr std::size_t capacity() { return N; }
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	// Grows or shrinks within the capacity; new elements are value-initialized
+	void resize(std::size_t size)
+	{
+		size = std::min(size, N);
+		for (std::size_t i = size_; i < size; ++i)
+			data_[i] = T{};
+		size_ = size;
+	}
+
+	bool push_back(const T &value)
+	{
+		if (size_ == N)
+			return false;
+		data_[size_++] = value;
+		return true;
+	}
+
+	void clear() { size_ = 0; }
+
+	T &operator[](std::size_t i) { return data_[i]; }
+	const T &operator[](std::size_t i) const { return data_[i]; }
+	T *data() { return data_.data(); }
+	const T *data() const { return data_.data(); }
+	T *begin() { return data_.data(); }
+	T *end() { return data_.data() + size_; }
+	const T *begin() const { return data_.data(); }
+	const T *end() const { return data_.data() + size_; }
+
+	bool operator==(const FixedVector &other) const
+	{
+		return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+	}
+	bool operator!=(const FixedVector &other) const { return !(*this == other); }
+
+private:
+	std::array<T, N> data_{};
+	std::size_t size_ = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------
+// Read-only map from ComponentId to a dense slot, built once the
+// ID set is final. The IDs are sorted into one flat array and split
+// into about one bucket per ID by their top bits. FNV-1a IDs are
+// spread evenly, so a lookup is a bucket fetch plus a scan of one
+// or two neighbouring entries, with no nodes to chase.
+// ------------------------------------------------------------
+class IdIndex
+{
+public:
+	static constexpr uint32_t none = UINT32_MAX;
+
+	// ids[slot] is the ID stored in that slot. If an ID occurs twice,
+	// the higher slot wins.
+	void build(const std::vector<uint64_t> &ids)
+	{
+		std::vector<std::pair<uint64_t, uint32_t>> entries;
+		entries.reserve(ids.size());
+		for (std::size_t slot = 0; slot < ids.size(); ++slot)
+			entries.emplace_back(ids[slot], static_cast<uint32_t>(slot));
+		std::sort(entries.begin(), entries.end());
+
+		ids_.clear();
+		slots_.clear();
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			if (i + 1 < entries.size() && entries[i + 1].first == entries[i].first)
+				continue;
+			ids_.push_back(entries[i].first);
+			slots_.push_back(entries[i].second);
+		}
+
+		unsigned bits = 0;
+		while ((std::size_t(1) << bits) < ids_.size())
+			++bits;
+		shift_ = 64 - bits;
+		starts_.assign((std::size_t(1) << bits) + 1, 0);
+		std::size_t position = 0;
+		for (std::size_t bucket = 0; bucket < starts_.size(); ++bucket)
+		{
+			while (position < ids_.size() && bucketOf(ids_[position]) < bucket)
+				++position;
+			starts_[bucket] = static_cast<uint32_t>(position);
+		}
+	}
+
+	uint32_t find(uint64_t id) const
+	{
+		if (ids_.empty())
+			return none;
+		std::size_t bucket = bucketOf(id);
+		for (uint32_t i = starts_[bucket]; i < starts_[bucket + 1]; ++i)
+		{
+			if (ids_[i] == id)
+				return slots_[i];
+		}
+		return none;
+	}
+
+	std::size_t size() const { return ids_.size(); }
+
+private:
+	// A shift by 64 is undefined, so a single bucket is special-cased
+	std::size_t bucketOf(uint64_t id) const { return shift_ == 64 ? 0 : static_cast<std::size_t>(id >> shift_); }
+
+	std::vector<uint64_t> ids_;
+	std::vector<uint32_t> slots_;
+	std::vector<uint32_t> starts_;
+	unsigned shift_ = 64;
+};
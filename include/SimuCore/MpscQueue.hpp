@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// ------------------------------------------------------------
+// Bounded lock-free queue: any number of producer threads, one
+// consumer. Each cell carries a sequence number that says whose
+// turn it is, so producers only contend on a single counter and
+// never wait for each other or for the consumer. push() fails
+// instead of blocking when the queue is full.
+// ------------------------------------------------------------
+template <typename T, std::size_t Capacity>
+class MpscQueue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	MpscQueue()
+	{
+		for (std::size_t i = 0; i < Capacity; ++i)
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	MpscQueue(const MpscQueue &) = delete;
+	MpscQueue &operator=(const MpscQueue &) = delete;
+
+	// Any thread
+	bool push(T value)
+	{
+		std::size_t position = tail_.load(std::memory_order_relaxed);
+		Cell *cell;
+		for (;;)
+		{
+			cell = &cells_[position & (Capacity - 1)];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t distance = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+			if (distance == 0)
+			{
+				if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (distance < 0)
+				return false;
+			else
+				position = tail_.load(std::memory_order_relaxed);
+		}
+		cell->value = std::move(value);
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer thread only
+	bool pop(T &value)
+	{
+		Cell &cell = cells_[head_ & (Capacity - 1)];
+		if (cell.sequence.load(std::memory_order_acquire) != head_ + 1)
+			return false;
+		value = std::move(cell.value);
+		cell.sequence.store(head_ + Capacity, std::memory_order_release);
+		++head_;
+		return true;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	std::array<Cell, Capacity> cells_;
+	alignas(64) std::atomic<std::size_t> tail_{0};
+	alignas(64) std::size_t head_ = 0;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <SimuCore/Component.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ------------------------------------------------------------
+// Name-based lookup over full component paths such as
+// "App->Motor3->Speed". The tree is copied into one flat array
+// where each node's children sit next to each other, sorted by
+// name, so each path segment is resolved with a binary search.
+//
+// Patterns are paths whose segments may use glob wildcards:
+//   *   any run of characters within one segment
+//   ?   any single character
+//   **  a whole segment matching zero or more levels
+// e.g. "App->Motor*->Speed" or "App->Motor3->**" (the subtree).
+//
+// Built once on the tick thread; any thread may query afterwards.
+// Queries made before build() return nothing.
+// ------------------------------------------------------------
+class PathIndex
+{
+public:
+	void build(Component *root);
+	bool isBuilt() const { return built_.load(std::memory_order_acquire); }
+
+	// The component with exactly this path, or nullptr
+	Component *find(std::string_view path) const;
+
+	// Appends every component matching pattern, depth first with
+	// siblings sorted by name (not in the order they were added)
+	void match(std::string_view pattern, std::vector<Component *> &matches) const;
+
+	std::size_t size() const { return nodes_.size(); }
+
+	static bool globMatch(std::string_view pattern, std::string_view text);
+
+private:
+	struct Node
+	{
+		std::string name;
+		Component *component;
+		uint32_t first_child;
+		uint32_t child_count;
+	};
+
+	// Children of node whose name starts with prefix
+	std::pair<uint32_t, uint32_t> childrenWithPrefix(const Node &node, std::string_view prefix, bool exact) const;
+	void matchFrom(uint32_t node, const std::vector<std::string_view> &segments, std::size_t segment,
+				   std::vector<Component *> &matches) const;
+
+	// nodes_[0] is a nameless node whose only child is the root
+	std::vector<Node> nodes_;
+	std::atomic<bool> built_{false};
+};
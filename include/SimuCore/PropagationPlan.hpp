@@ -0,0 +1,190 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SimuCore/SimuCoreContext.hpp>
+
+template <typename T>
+class Signal;
+template <typename T>
+class InputSignal;
+template <typename T>
+class OutputSignal;
+
+// ------------------------------------------------------------
+// Compiled propagation plan
+//
+// Once bindSignals() has run, every OutputSignal's bindings are
+// flattened into one table per value type: a route per output
+// pointing at a contiguous run of destination inputs. Publishing
+// then walks that run, and a double-buffered commit is a single
+// pass over each table instead of a virtual call per output.
+// ------------------------------------------------------------
+class PropagationTableBase
+{
+public:
+	virtual ~PropagationTableBase() = default;
+	virtual void clear() = 0;
+	virtual void commitAll() = 0;
+	virtual std::size_t routeCount() const = 0;
+	virtual std::size_t destinationCount() const = 0;
+	virtual void dump(std::string &text) const = 0;
+};
+
+// Every table that holds at least one route
+class PropagationPlan
+{
+public:
+	static PropagationPlan &getInstance() { return SimuCoreContext::active<PropagationPlan>(); }
+
+	void addTable(PropagationTableBase *table) { tables_.push_back(table); }
+	const std::vector<PropagationTableBase *> &getTables() const { return tables_; }
+	bool isCompiled() const { return compiled_; }
+	void setCompiled() { compiled_ = true; }
+
+	void clear()
+	{
+		for (auto *table : tables_)
+			table->clear();
+		tables_.clear();
+		compiled_ = false;
+	}
+
+	void commitAll()
+	{
+		for (auto *table : tables_)
+			table->commitAll();
+	}
+
+	std::size_t routeCount() const
+	{
+		std::size_t routes = 0;
+		for (auto *table : tables_)
+			routes += table->routeCount();
+		return routes;
+	}
+
+	std::size_t destinationCount() const
+	{
+		std::size_t destinations = 0;
+		for (auto *table : tables_)
+			destinations += table->destinationCount();
+		return destinations;
+	}
+
+	// One line per route: "<type> <output> -> <input>, <input> (alias <input>)"
+	std::string dump() const
+	{
+		std::string text;
+		for (auto *table : tables_)
+			table->dump(text);
+		return text;
+	}
+
+private:
+	friend class SimuCoreContext;
+	PropagationPlan() = default;
+	PropagationPlan(const PropagationPlan &) = delete;
+	PropagationPlan &operator=(const PropagationPlan &) = delete;
+
+	std::vector<PropagationTableBase *> tables_;
+	bool compiled_ = false;
+};
+
+template <typename T>
+class PropagationTable : public PropagationTableBase
+{
+public:
+	static constexpr uint32_t noRoute = UINT32_MAX;
+
+	static PropagationTable &getInstance() { return SimuCoreContext::active<PropagationTable>(); }
+
+	uint32_t addRoute(OutputSignal<T> *source,
+					  const std::vector<InputSignal<T> *> &copies,
+					  const std::vector<InputSignal<T> *> &aliases)
+	{
+		if (routes_.empty())
+			PropagationPlan::getInstance().addTable(this);
+		Route route{source,
+					static_cast<uint32_t>(copies_.size()), static_cast<uint32_t>(copies.size()),
+					static_cast<uint32_t>(aliases_.size()), static_cast<uint32_t>(aliases.size())};
+		copies_.insert(copies_.end(), copies.begin(), copies.end());
+		aliases_.insert(aliases_.end(), aliases.begin(), aliases.end());
+		routes_.push_back(route);
+		return static_cast<uint32_t>(routes_.size() - 1);
+	}
+
+	void propagate(uint32_t index, const T &value, bool changed)
+	{
+		const Route &route = routes_[index];
+		InputSignal<T> *const *input = copies_.data() + route.first_copy;
+		for (uint32_t i = 0; i < route.copy_count; ++i)
+			input[i]->Signal<T>::setValue(value);
+		if (!changed)
+			return;
+		input = aliases_.data() + route.first_alias;
+		for (uint32_t i = 0; i < route.alias_count; ++i)
+			input[i]->markChanged();
+	}
+
+	void commitAll() override
+	{
+		for (auto &route : routes_)
+			route.source->OutputSignal<T>::commit();
+	}
+
+	void clear() override
+	{
+		for (auto &route : routes_)
+			route.source->route_ = noRoute;
+		routes_.clear();
+		copies_.clear();
+		aliases_.clear();
+	}
+
+	std::size_t routeCount() const override { return routes_.size(); }
+	std::size_t destinationCount() const override { return copies_.size() + aliases_.size(); }
+
+	void dump(std::string &text) const override
+	{
+		for (const auto &route : routes_)
+		{
+			text += route.source->getTypeName();
+			text += ' ';
+			text += route.source->getFullName();
+			text += " ->";
+			for (uint32_t i = 0; i < route.copy_count; ++i)
+			{
+				text += i ? ", " : " ";
+				text += copies_[route.first_copy + i]->getFullName();
+			}
+			for (uint32_t i = 0; i < route.alias_count; ++i)
+			{
+				text += " (alias ";
+				text += aliases_[route.first_alias + i]->getFullName();
+				text += ')';
+			}
+			text += '\n';
+		}
+	}
+
+private:
+	struct Route
+	{
+		OutputSignal<T> *source;
+		uint32_t first_copy;
+		uint32_t copy_count;
+		uint32_t first_alias;
+		uint32_t alias_count;
+	};
+
+	friend class SimuCoreContext;
+	PropagationTable() = default;
+	PropagationTable(const PropagationTable &) = delete;
+	PropagationTable &operator=(const PropagationTable &) = delete;
+
+	std::vector<Route> routes_;
+	std::vector<InputSignal<T> *> copies_;
+	std::vector<InputSignal<T> *> aliases_;
+};
@@ -1,11 +1,28 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include <type_traits>
-#include <typeinfo>
 #include <iostream>
+#include <cmath>
+#include <functional>
 #include <SimuCore/Component.hpp>
+#include <SimuCore/SignalStore.hpp>
+#include <SimuCore/DirtyBitmap.hpp>
+#include <SimuCore/ChangeIndex.hpp>
+#include <SimuCore/IdIndex.hpp>
+#include <SimuCore/SignalSnapshot.hpp>
+#include <SimuCore/SignalConversion.hpp>
+#include <SimuCore/SignalType.hpp>
+#include <SimuCore/Span.hpp>
+#include <SimuCore/SignalHistory.hpp>
+#include <SimuCore/PropagationPlan.hpp>
 #include <SimuCore/json.hpp>
 
 // ------------------------------------------------------------
@@ -30,121 +47,351 @@ struct SetValueResponse
 class SignalBase : public Component
 {
 public:
-	SignalBase(Component *owner, const std::string &name, ComponentType componentType)
-		: Component(owner, name, componentType) {}
+	SignalBase(Component *owner, const std::string &name, ComponentType componentType, SignalType type)
+		: Component(owner, name, componentType), type_(type) {}
 	virtual ~SignalBase() = default;
 
 	virtual void registerSignal() = 0;
-	virtual std::string getTypeName() const = 0;
+	SignalType getType() const { return type_; }
+	virtual const char *getTypeName() const = 0;
 	virtual std::string getValueAsString() const = 0;
+	// Value as of the last completed tick; safe to call from any thread
+	virtual std::string getValueAsString(const SnapshotView &snapshot) const = 0;
+	// True if the snapshot could only hold part of the value (see snapshotStringCapacity)
+	virtual bool isTruncated(const SnapshotView &snapshot) const = 0;
 	virtual SetValueResponse setValueFromString(const std::string &value) = 0;
-	virtual bool valueHasChanged() = 0;
+	// Element-range update of an array-valued signal
+	virtual SetValueResponse setElementsFromStrings(std::size_t offset, const std::vector<std::string> &values) = 0;
+	// The response the matching set call would give, without storing anything
+	virtual SetValueResponse checkValueFromString(const std::string &value) = 0;
+	virtual SetValueResponse checkElementsFromStrings(std::size_t offset, const std::vector<std::string> &values) = 0;
+	// Stores the value whatever the component type; see SignalRegistry::force()
+	virtual SetValueResponse forceFromString(const std::string &value) = 0;
 	virtual void reset_signal() = 0;
+	// Adds the state that SignalRegistry::reset_signals() restores
+	virtual void captureState(SignalImage &) {}
+	// Publishes a value buffered during a double-buffered tick
+	virtual void commit() {}
+	// Adds this signal's bindings to the PropagationPlan
+	virtual void compileBindings() {}
+	virtual std::size_t getSnapshotSize() const = 0;
+	virtual void writeSnapshot(SignalSnapshot &snapshot) const = 0;
+	// Brings a lazily computed value (DerivedSignal) up to date; tick thread only
+	virtual void evaluate() const {}
 
 	void init() override {}
 	void execute() override {}
 
-	std::vector<SignalBase *> getConnectedBaseSignals() const { return connectedBaseSignals_; }
-	void addBaseSignal(SignalBase *signal) { connectedBaseSignals_.push_back(signal); }
+	Span<SignalBase *const> getConnectedBaseSignals() const { return getInfo().bindings; }
+	void addBaseSignal(SignalBase *signal) { getInfo().bindings.push_back(signal); }
+
+	// Dense 0..N-1 position in the SignalRegistry, or unregistered if
+	// the registry refused the signal (see SignalRegistry::add())
+	static constexpr uint32_t unregistered = UINT32_MAX;
+	uint32_t getIndex() const { return index_; }
+	bool isRegistered() const { return index_ != unregistered; }
+
+	// True if the value changed since the end of the previous tick
+	bool valueHasChanged() const;
+	// True while SignalRegistry::force() pins the value
+	bool isForced() const;
+	// Tick during which the value last changed, as of the last endTick()
+	uint64_t getLastChangedTick() const;
+
+	void markChanged() const;
 
 protected:
-	std::vector<SignalBase *> connectedBaseSignals_;
+	uint32_t getSnapshotOffset() const { return snapshot_offset_; }
+
+	// Parameters & physical I/O can be set, but internal signals are read-only
+	bool isWritable() const
+	{
+		return getComponentType() == ComponentType::PHYSICAL_INPUT ||
+			   getComponentType() == ComponentType::PHYSICAL_OUTPUT ||
+			   getComponentType() == ComponentType::PARAMETER;
+	}
+
+	static SetValueResponse readOnlyResponse()
+	{
+		return {SetValueByStringResult::ReadOnly,
+				"Cannot set value! Only Physical I/O and Parameters are writable"};
+	}
+
+	// Where Signal<T>::getValue() finds the value
+	enum class ReadMode : uint8_t
+	{
+		Stored,	 // in the signal's own storage
+		Aliased, // in the storage of the output an input is aliased to
+		Derived	 // in its own storage, once evaluate() has run
+	};
+	ReadMode read_mode_ = ReadMode::Stored;
+
+private:
+	uint32_t index_ = unregistered;
+	uint32_t snapshot_offset_ = 0;
+	SignalType type_;
+
+	friend class SignalRegistry;
+};
+
+template <typename T>
+class Signal;
+
+// ------------------------------------------------------------
+// Deadband for floating-point signals: a new value only counts as
+// a change (for telemetry, history and valueHasChanged) once it
+// moves more than max(absolute, relative * |reference|) away from
+// the last value that did. The limits are either fixed or read
+// from other signals, typically Parameters.
+// ------------------------------------------------------------
+template <typename T>
+struct Deadband
+{
+	T absolute = 0;
+	T relative = 0;
+	const Signal<T> *absolute_parameter = nullptr;
+	const Signal<T> *relative_parameter = nullptr;
+	T reference{};
+
+	bool isExceededBy(const T &value) const
+	{
+		T absolute_limit = absolute_parameter ? absolute_parameter->getValue() : absolute;
+		T relative_limit = relative_parameter ? relative_parameter->getValue() : relative;
+		return std::abs(value - reference) > std::max(absolute_limit, relative_limit * std::abs(reference));
+	}
+};
+
+// Only floating-point signals pay for the deadband pointer
+template <typename T, bool = std::is_floating_point_v<T>>
+class SignalDeadband
+{
+};
+
+template <typename T>
+class SignalDeadband<T, true>
+{
+protected:
+	std::unique_ptr<Deadband<T>> deadband_;
+};
+
+// Only bus signals (see Bus.hpp) own a signal per field
+template <typename T, bool = isBus<T>>
+class SignalBusFields
+{
+};
+
+template <typename T>
+class SignalBusFields<T, true>
+{
+public:
+	// One signal per field, in the order of T::fields()
+	const std::vector<std::unique_ptr<SignalBase>> &getFields() const { return fields_; }
+
+protected:
+	std::vector<std::unique_ptr<SignalBase>> fields_;
 };
 
 // ------------------------------------------------------------
 // Unified Signal<T>
 // ------------------------------------------------------------
 template <typename T>
-class Signal : public SignalBase
+class Signal : public SignalBase, public SignalDeadband<T>, public SignalBusFields<T>
 {
 public:
 	Signal(Component *owner, const std::string &name,
 		   ComponentType componentType, const T &initial_value = T{})
-		: SignalBase(owner, name, componentType),
-		  value_(initial_value), last_value_(initial_value), initial_value(initial_value)
+		: SignalBase(owner, name, componentType, SignalTypeInfo<T>::tag), storage_(initial_value)
 	{
 		registerSignal();
+		if constexpr (isBus<T>)
+			addBusFields();
 	}
 
 	virtual void reset_signal() override {
-		this->setValue(initial_value);
+		this->setValue(storage_.initialValue());
 	}
 
-	// Value access
-	virtual void setValue(const T &value)
+	void captureState(SignalImage &image) override
 	{
-		last_value_ = value_;
-		value_ = value;
+		storage_.capture(image);
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			if (this->deadband_)
+				image.add(this->deadband_->reference);
+		}
+	}
+
+	// Value access. Every read goes through getValue(), whatever the
+	// static type: aliased inputs read their output and derived
+	// signals are computed first, which costs stored values one branch.
+	virtual void setValue(const T &value) { storeValue(value); }
+	const T &getValue() const
+	{
+		if (this->read_mode_ == ReadMode::Stored)
+			return storage_.value();
+		return readIndirect();
 	}
-	const T &getValue() const { return value_; }
 
 	// Introspection
-	std::string getTypeName() const override { return typeid(T).name(); }
+	const char *getTypeName() const override { return SignalTypeInfo<T>::name(); }
 
-	std::string getValueAsString() const override
+	std::string getValueAsString() const override { return SignalConversion::toString(getValue()); }
+	std::string getValueAsString(const SnapshotView &snapshot) const override
 	{
-		if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>)
-			return std::to_string(value_);
-		else if constexpr (std::is_same_v<T, bool>)
-			return value_ ? "true" : "false";
-		else if constexpr (std::is_same_v<T, std::string>)
-			return value_;
-		else
-			return "Unsupported type";
+		if (!snapshot.isValid())
+			return getValueAsString();
+		using Traits = SnapshotTraits<T>;
+		return SignalConversion::toString(Traits::load(snapshot.read<typename Traits::Stored>(this->getSnapshotOffset())));
+	}
+	bool isTruncated(const SnapshotView &snapshot) const override
+	{
+		if (!snapshot.isValid())
+			return false;
+		using Traits = SnapshotTraits<T>;
+		return Traits::truncated(snapshot.read<typename Traits::Stored>(this->getSnapshotOffset()));
 	}
 
-	SetValueResponse setValueFromString(const std::string &value) override
+	SetValueResponse setValueFromString(const std::string &value) override { return valueFromString(value, true); }
+	SetValueResponse checkValueFromString(const std::string &value) override { return valueFromString(value, false); }
+
+	SetValueResponse setElementsFromStrings(std::size_t offset, const std::vector<std::string> &values) override
 	{
-		// Parameters & physical I/O can be set, but internal signals are read-only
-		if (getComponentType() != ComponentType::PHYSICAL_INPUT &&
-			getComponentType() != ComponentType::PHYSICAL_OUTPUT &&
-			getComponentType() != ComponentType::PARAMETER)
-		{
-			return {SetValueByStringResult::ReadOnly,
-					"Cannot set value! Only Physical I/O and Parameters are writable"};
-		}
+		return elementsFromStrings(offset, values, true);
+	}
+	SetValueResponse checkElementsFromStrings(std::size_t offset, const std::vector<std::string> &values) override
+	{
+		return elementsFromStrings(offset, values, false);
+	}
+
+	SetValueResponse forceFromString(const std::string &value) override
+	{
+		if constexpr (!SignalConversion::isSupported<T>())
+			return {SetValueByStringResult::UnsupportedType, "Unsupported type"};
 
-		try
+		T converted = storage_.value();
+		if (!SignalConversion::fromString(value, converted))
+			return {SetValueByStringResult::UnsupportedType, "Conversion failed"};
+		forceValue(converted);
+		return {SetValueByStringResult::Success, "Success"};
+	}
+
+	void registerSignal() override;
+
+	std::size_t getSnapshotSize() const override { return sizeof(typename SnapshotTraits<T>::Stored); }
+	void writeSnapshot(SignalSnapshot &snapshot) const override
+	{
+		snapshot.write(this->getSnapshotOffset(), SnapshotTraits<T>::store(getValue()));
+	}
+
+	// Record the last `depth` end-of-tick values, fetched with GET_HISTORY
+	void enableHistory(std::size_t depth);
+
+	void setDeadband(T absolute, T relative = 0)
+	{
+		static_assert(std::is_floating_point_v<T>, "Deadbands are only supported for floating-point signals");
+		Deadband<T> &deadband = getDeadband();
+		deadband.absolute = absolute;
+		deadband.relative = relative;
+	}
+
+	void setDeadband(const Signal<T> &absolute, const Signal<T> *relative = nullptr)
+	{
+		static_assert(std::is_floating_point_v<T>, "Deadbands are only supported for floating-point signals");
+		Deadband<T> &deadband = getDeadband();
+		deadband.absolute_parameter = &absolute;
+		deadband.relative_parameter = relative;
+	}
+
+protected:
+	// Stores the value and returns true if it counts as a change.
+	// Forced signals keep their value.
+	bool storeValue(const T &value) const
+	{
+		if (this->isForced())
+			return false;
+		if constexpr (isBus<T>)
 		{
-			if constexpr (std::is_same_v<T, int>)
-				setValue(std::stoi(value));
-			else if constexpr (std::is_same_v<T, bool>)
-				setValue(value == "true");
-			else if constexpr (std::is_same_v<T, float>)
-				setValue(std::stof(value));
-			else if constexpr (std::is_same_v<T, double>)
-				setValue(std::stod(value));
-			else if constexpr (std::is_same_v<T, std::string>)
-				setValue(value);
-			else
-				return {SetValueByStringResult::UnsupportedType, "Unsupported type"};
+			if (!markChangedFields(value))
+				return false;
 		}
-		catch (...)
+		else if (storage_.value() == value)
+			return false;
+		storage_.value() = value;
+		if constexpr (std::is_floating_point_v<T>)
 		{
-			return {SetValueByStringResult::UnsupportedType, "Conversion failed"};
+			if (this->deadband_)
+			{
+				if (!this->deadband_->isExceededBy(value))
+					return false;
+				this->deadband_->reference = value;
+			}
 		}
-
-		return {SetValueByStringResult::Success, "Success"};
+		this->markChanged();
+		return true;
 	}
 
-	bool valueHasChanged() override
+	Deadband<T> &getDeadband()
 	{
-		if (first_read_)
+		if (!this->deadband_)
 		{
-			first_read_ = false;
-			return true;
+			this->deadband_ = std::make_unique<Deadband<T>>();
+			this->deadband_->reference = storage_.value();
 		}
-		return value_ != last_value_;
+		return *this->deadband_;
 	}
 
-	void registerSignal() override;
+	// Marks every field that differs from value; true if any does
+	bool markChangedFields(const T &value) const
+	{
+		bool changed = false;
+		forEachBusField<T>([&](std::size_t index, const char *, auto member)
+						   {
+			if (storage_.value().*member == value.*member)
+				return;
+			this->fields_[index]->markChanged();
+			changed = true; });
+		return changed;
+	}
 
-	
-protected:
-	T value_;
-	T initial_value;
-	T last_value_;
-	bool first_read_ = true;
+	void addBusFields();
+
+	// Takes effect at once, even where setValue() is deferred
+	virtual void forceValue(const T &value) { storeValue(value); }
+
+	const T &readIndirect() const;
+
+	SetValueResponse valueFromString(const std::string &value, bool store)
+	{
+		if (!isWritable())
+			return readOnlyResponse();
+		if constexpr (!SignalConversion::isSupported<T>())
+			return {SetValueByStringResult::UnsupportedType, "Unsupported type"};
+
+		T converted = storage_.value();
+		if (!SignalConversion::fromString(value, converted))
+			return {SetValueByStringResult::UnsupportedType, "Conversion failed"};
+		if (store)
+			setValue(converted);
+		return {SetValueByStringResult::Success, "Success"};
+	}
+
+	SetValueResponse elementsFromStrings(std::size_t offset, const std::vector<std::string> &values, bool store)
+	{
+		if (!isWritable())
+			return readOnlyResponse();
+		if constexpr (!SignalArrayTraits<T>::isArray)
+			return {SetValueByStringResult::UnsupportedType, "Not an array signal"};
+
+		T converted = storage_.value();
+		if (!SignalConversion::elementsFromStrings(offset, values, converted))
+			return {SetValueByStringResult::UnsupportedType, "Conversion failed"};
+		if (store)
+			setValue(converted);
+		return {SetValueByStringResult::Success, "Success"};
+	}
+
+	// Mutable so that a DerivedSignal can cache its value while being read
+	mutable SignalValueStorage<T> storage_;
 };
 
 // ------------------------------------------------------------
@@ -156,32 +403,138 @@ class InputSignal : public Signal<T>
 public:
 	InputSignal(Component *owner, const std::string &name, const T &initial_value = T{})
 		: Signal<T>(owner, name, ComponentType::INTERNAL_INPUT, initial_value) {}
+
+	SetValueResponse forceFromString(const std::string &value) override
+	{
+		if (isAliased())
+			return {SetValueByStringResult::UnsupportedType, "Aliased inputs read their output; force the output instead"};
+		return Signal<T>::forceFromString(value);
+	}
+
+	// From now on reads go straight to source's storage
+	void aliasTo(const Signal<T> *source)
+	{
+		source_ = source;
+		this->read_mode_ = SignalBase::ReadMode::Aliased;
+	}
+	bool isAliased() const { return source_ != nullptr; }
+
+private:
+	const Signal<T> *source_ = nullptr;
+
+	friend class Signal<T>;
 };
 
 template <typename T>
 class OutputSignal : public Signal<T>
 {
 private:
-	std::vector<InputSignal<T> *> connected_inputs_;
+	T next_value_{};
+	bool pending_commit_ = false;
+	uint32_t route_ = PropagationTable<T>::noRoute;
+
+	friend class PropagationTable<T>;
+
+	// Bound inputs are kept with the cold metadata; only connectTo()
+	// and aliasTo() add to it, so every entry is an InputSignal<T>
+	const std::vector<SignalBase *> &getBoundInputs() const { return this->getInfo().bindings; }
+
+	bool isConnected(InputSignal<T> *input) const
+	{
+		const auto &inputs = getBoundInputs();
+		return std::find(inputs.begin(), inputs.end(), input) != inputs.end();
+	}
+
+protected:
+	bool hasBoundInputs() const { return !getBoundInputs().empty(); }
+
+	// Bypasses double buffering and reaches the bound inputs right away
+	void forceValue(const T &value) override
+	{
+		pending_commit_ = false;
+		publish(value);
+	}
+
+	void publish(const T &value) const
+	{
+		bool changed = this->storeValue(value);
+		if (route_ != PropagationTable<T>::noRoute)
+		{
+			PropagationTable<T>::getInstance().propagate(route_, this->getValue(), changed);
+			return;
+		}
+		for (auto *signal : getBoundInputs())
+		{
+			auto *input = static_cast<InputSignal<T> *>(signal);
+			if (!input->isAliased())
+				input->setValue(this->getValue());
+			else if (changed)
+				input->markChanged();
+		}
+	}
 
 public:
-	OutputSignal(Component *owner, const std::string &name, const T &initial_value = T{})
-		: Signal<T>(owner, name, ComponentType::INTERNAL_OUTPUT, initial_value) {}
+	OutputSignal(Component *owner, const std::string &name, const T &initial_value = T{});
+
+	// In double-buffered mode the value is held back until commit(), so
+	// every component reads the values of the previous tick
+	void setValue(const T &value) override;
+
+	void commit() override
+	{
+		if (!pending_commit_)
+			return;
+		pending_commit_ = false;
+		publish(next_value_);
+	}
+
+	void reset_signal() override
+	{
+		pending_commit_ = false;
+		publish(this->storage_.initialValue());
+	}
 
-	void setValue(const T &value) override
+	void compileBindings() override
 	{
-		this->last_value_ = this->value_;
-		this->value_ = value;
-		for (auto *input : connected_inputs_)
-			input->setValue(this->value_);
+		std::vector<InputSignal<T> *> copies;
+		std::vector<InputSignal<T> *> aliases;
+		for (auto *signal : getBoundInputs())
+		{
+			auto *input = static_cast<InputSignal<T> *>(signal);
+			(input->isAliased() ? aliases : copies).push_back(input);
+		}
+		route_ = PropagationTable<T>::getInstance().addRoute(this, copies, aliases);
 	}
 
+	// Bindings made after the plan was compiled fall back to walking
+	// the bound inputs until the plan is compiled again
 	void connectTo(InputSignal<T> *input)
 	{
-		if (std::find(connected_inputs_.begin(), connected_inputs_.end(), input) != connected_inputs_.end())
+		if (isConnected(input))
         	return;
-		connected_inputs_.push_back(input);
-		input->setValue(this->value_);
+		route_ = PropagationTable<T>::noRoute;
+		input->setValue(this->getValue());
+		this->addBaseSignal(input);
+		if constexpr (isBus<T>)
+			for (std::size_t i = 0; i < this->fields_.size(); ++i)
+				this->fields_[i]->addBaseSignal(input->getFields()[i].get());
+	}
+
+	// Zero-copy binding: the input reads this output's value in place
+	// and is only marked as changed when a new value is published.
+	// Bus fields read their own bus's value, so buses are always copied.
+	void aliasTo(InputSignal<T> *input)
+	{
+		if constexpr (isBus<T>)
+		{
+			connectTo(input);
+			return;
+		}
+		if (isConnected(input))
+			return;
+		route_ = PropagationTable<T>::noRoute;
+		input->aliasTo(this);
+		input->markChanged();
 		this->addBaseSignal(input);
 	}
 };
@@ -210,65 +563,821 @@ public:
 		: Signal<T>(owner, name, ComponentType::PARAMETER, initial_value) {}
 };
 
+// ------------------------------------------------------------
+// Output computed from other signals on demand instead of in
+// execute(). It is recomputed at most once per tick, only when one
+// of its sources changed since the last computation, and only when
+// something reads it: getValue(), a telemetry subscription, or, at
+// the end of each tick, bound inputs and its history. Clients that
+// read the snapshot (APPLICATION_TREE, GET_CHANGES) have the tick
+// thread refresh it first, see SignalRegistry::requestDerivedValues().
+// The value bypasses double buffering, since it is a function of
+// values that already obey it.
+// ------------------------------------------------------------
+class DerivedSignalBase
+{
+public:
+	virtual ~DerivedSignalBase() = default;
+	// True if bound inputs or a history take the value every tick
+	virtual bool hasReader() const = 0;
+	// End of tick: recomputes the value if a source changed
+	virtual void evaluateAtEndOfTick() = 0;
+	// Between ticks, for a client: recomputes the value if a source
+	// changed, and checks the sources again at the end of the tick
+	virtual void evaluateOnDemand() = 0;
+	// Forgets the cached value, e.g. after a reset
+	virtual void invalidate() = 0;
+};
+
+template <typename T>
+class DerivedSignal : public OutputSignal<T>, public DerivedSignalBase
+{
+public:
+	DerivedSignal(Component *owner, const std::string &name, std::function<T()> compute,
+				  std::vector<const SignalBase *> sources);
+
+	// Caching leaves the observable value unchanged, hence const
+	void evaluate() const override { refresh(); }
+
+	bool hasReader() const override;
+
+	void evaluateAtEndOfTick() override { refresh(); }
+
+	void evaluateOnDemand() override
+	{
+		refresh();
+		// Sources may still change during this tick
+		evaluated_between_ticks_ = true;
+	}
+
+	void invalidate() override { evaluated_ = false; }
+
+	// The value as last computed: writing the snapshot never computes it
+	void writeSnapshot(SignalSnapshot &snapshot) const override
+	{
+		snapshot.write(this->getSnapshotOffset(), SnapshotTraits<T>::store(this->storage_.value()));
+	}
+
+private:
+	void refresh() const;
+
+	std::function<T()> compute_;
+	std::vector<const SignalBase *> sources_;
+	mutable uint64_t evaluated_tick_ = 0;
+	mutable bool evaluated_ = false;
+	mutable bool evaluated_between_ticks_ = false;
+};
+
+// ------------------------------------------------------------
+// One field of a bus signal. Holds no value of its own: it reads
+// and writes its member of the bus's value, and is marked changed
+// by the bus when that member changes.
+// ------------------------------------------------------------
+template <typename S, typename T>
+class BusField : public SignalBase
+{
+public:
+	BusField(Signal<S> *bus, const char *name, T S::*member)
+		: SignalBase(bus, name, bus->getComponentType(), SignalTypeInfo<T>::tag), bus_(bus), member_(member)
+	{
+		registerSignal();
+	}
+
+	const T &getValue() const { return bus_->getValue().*member_; }
+
+	const char *getTypeName() const override { return SignalTypeInfo<T>::name(); }
+
+	std::string getValueAsString() const override { return SignalConversion::toString(getValue()); }
+	std::string getValueAsString(const SnapshotView &snapshot) const override
+	{
+		if (!snapshot.isValid())
+			return getValueAsString();
+		using Traits = SnapshotTraits<T>;
+		return SignalConversion::toString(Traits::load(snapshot.read<typename Traits::Stored>(this->getSnapshotOffset())));
+	}
+	bool isTruncated(const SnapshotView &snapshot) const override
+	{
+		if (!snapshot.isValid())
+			return false;
+		using Traits = SnapshotTraits<T>;
+		return Traits::truncated(snapshot.read<typename Traits::Stored>(this->getSnapshotOffset()));
+	}
+
+	SetValueResponse setValueFromString(const std::string &value) override { return valueFromString(value, true); }
+	SetValueResponse checkValueFromString(const std::string &value) override { return valueFromString(value, false); }
+
+	SetValueResponse setElementsFromStrings(std::size_t offset, const std::vector<std::string> &values) override
+	{
+		return elementsFromStrings(offset, values, true);
+	}
+	SetValueResponse checkElementsFromStrings(std::size_t offset, const std::vector<std::string> &values) override
+	{
+		return elementsFromStrings(offset, values, false);
+	}
+
+	SetValueResponse forceFromString(const std::string &) override
+	{
+		return {SetValueByStringResult::UnsupportedType, "Bus fields cannot be forced"};
+	}
+
+	// Reset together with the rest of the bus
+	void reset_signal() override {}
+
+	void registerSignal() override;
+
+	std::size_t getSnapshotSize() const override { return sizeof(typename SnapshotTraits<T>::Stored); }
+	void writeSnapshot(SignalSnapshot &snapshot) const override
+	{
+		snapshot.write(this->getSnapshotOffset(), SnapshotTraits<T>::store(getValue()));
+	}
+
+private:
+	SetValueResponse valueFromString(const std::string &value, bool store)
+	{
+		if (!isWritable())
+			return readOnlyResponse();
+		if constexpr (!SignalConversion::isSupported<T>())
+			return {SetValueByStringResult::UnsupportedType, "Unsupported type"};
+
+		S converted = bus_->getValue();
+		if (!SignalConversion::fromString(value, converted.*member_))
+			return {SetValueByStringResult::UnsupportedType, "Conversion failed"};
+		if (store)
+			bus_->setValue(converted);
+		return {SetValueByStringResult::Success, "Success"};
+	}
+
+	SetValueResponse elementsFromStrings(std::size_t offset, const std::vector<std::string> &values, bool store)
+	{
+		if (!isWritable())
+			return readOnlyResponse();
+		if constexpr (!SignalArrayTraits<T>::isArray)
+			return {SetValueByStringResult::UnsupportedType, "Not an array signal"};
+
+		S converted = bus_->getValue();
+		if (!SignalConversion::elementsFromStrings(offset, values, converted.*member_))
+			return {SetValueByStringResult::UnsupportedType, "Conversion failed"};
+		if (store)
+			bus_->setValue(converted);
+		return {SetValueByStringResult::Success, "Success"};
+	}
+
+	Signal<S> *bus_;
+	T S::*member_;
+};
+
 // ------------------------------------------------------------
 // Signal Registry
 // ------------------------------------------------------------
 class SignalRegistry
 {
 public:
-	static SignalRegistry &getInstance()
+	// The active SimuCoreContext's registry
+	static SignalRegistry &getInstance() { return SimuCoreContext::active<SignalRegistry>(); }
+
+	const SignalBase *find(const ComponentId id) const { return lookup(id); }
+
+	SignalBase *getSignalByIndex(uint32_t index) const { return signals_by_index_[index]; }
+
+	// Indices of the signals that changed since the end of the previous tick
+	const DirtyBitmap &getChangedSignals() const { return changed_; }
+
+	// Views are valid until the next signal is registered
+	Span<SignalBase *const> getAllSignals() const { return signals_by_index_; }
+
+	// Every signal of one kind, e.g. all PARAMETER signals, in registration order
+	Span<SignalBase *const> getSignalsOfType(ComponentType type) const
 	{
-		static SignalRegistry instance;
-		return instance;
+		return signals_by_type_[static_cast<std::size_t>(type)];
 	}
 
-	const SignalBase *find(const unsigned int id) const
+	SetValueResponse changeSignalValue(ComponentId id, const std::string &value)
 	{
-		auto it = signals_.find(id);
-		return (it != signals_.end()) ? it->second : nullptr;
+		SignalBase *signal = lookup(id);
+		if (!signal)
+			return unknownResponse(id);
+		if (signal->isForced())
+			return forcedResponse(id);
+		return signal->setValueFromString(value);
 	}
 
-	std::vector<SignalBase *> getAllSignals() const
+	SetValueResponse changeSignalElements(ComponentId id, std::size_t offset, const std::vector<std::string> &values)
 	{
-		std::vector<SignalBase *> allSignals;
-		allSignals.reserve(signals_.size());
-		for (auto &p : signals_)
-			allSignals.push_back(p.second);
-		return allSignals;
+		SignalBase *signal = lookup(id);
+		if (!signal)
+			return unknownResponse(id);
+		if (signal->isForced())
+			return forcedResponse(id);
+		return signal->setElementsFromStrings(offset, values);
 	}
 
-	void changeSignalValue(unsigned int id, const std::string &value)
+	// What changeSignalValue() and changeSignalElements() would answer
+	// right now, without changing anything
+	SetValueResponse checkSignalValue(ComponentId id, const std::string &value)
 	{
-		auto it = signals_.find(id);
-		if (it != signals_.end())
+		SignalBase *signal = lookup(id);
+		if (!signal)
+			return unknownResponse(id);
+		if (signal->isForced())
+			return forcedResponse(id);
+		return signal->checkValueFromString(value);
+	}
+
+	SetValueResponse checkSignalElements(ComponentId id, std::size_t offset, const std::vector<std::string> &values)
+	{
+		SignalBase *signal = lookup(id);
+		if (!signal)
+			return unknownResponse(id);
+		if (signal->isForced())
+			return forcedResponse(id);
+		return signal->checkElementsFromStrings(offset, values);
+	}
+
+	// Pins a signal, internal ones included, to value: every other write
+	// is ignored until release(), or until `ticks` more ticks have ended
+	// if ticks is not 0. Forcing a forced signal replaces its value.
+	SetValueResponse force(ComponentId id, const std::string &value, uint64_t ticks = 0)
+	{
+		SignalBase *signal = lookup(id);
+		if (!signal)
+			return unknownResponse(id);
+		bool was_forced = signal->isForced();
+		if (was_forced)
+			forced_.reset(signal->index_);
+		SetValueResponse response = signal->forceFromString(value);
+		if (response.result != SetValueByStringResult::Success)
 		{
-			auto response = it->second->setValueFromString(value);
+			if (was_forced)
+				forced_.set(signal->index_);
+			return response;
 		}
+		forced_.set(signal->index_);
+		auto force = std::find_if(forces_.begin(), forces_.end(), [&](const Force &f)
+								  { return f.index == signal->index_; });
+		if (force == forces_.end())
+			forces_.push_back({signal->index_, ticks});
+		else
+			force->ticks_remaining = ticks;
+		return response;
+	}
+
+	// False if the signal was not forced
+	bool release(ComponentId id)
+	{
+		SignalBase *signal = lookup(id);
+		if (!signal || !signal->isForced())
+			return false;
+		uint32_t index = signal->index_;
+		forced_.reset(index);
+		forces_.erase(std::find_if(forces_.begin(), forces_.end(), [&](const Force &f)
+								   { return f.index == index; }));
+		return true;
+	}
+
+	void releaseAll()
+	{
+		for (auto &force : forces_)
+			forced_.reset(force.index);
+		forces_.clear();
+	}
+
+	std::size_t getForcedCount() const { return forces_.size(); }
+
+	// Called once the application tree is complete. Checks that no two
+	// components ended up with the same ID, then swaps the hash map used
+	// during construction for a flat IdIndex over the final ID set.
+	// Returns false on a collision, including one add() refused for a
+	// signal outside the tree (Config parameters).
+	bool freeze(Component *root)
+	{
+		if (frozen_)
+			return !id_collision_;
+		frozen_ = true;
+
+		std::unordered_map<ComponentId, Component *> seen;
+		auto visit = [&](Component *component, auto &self) -> void
+		{
+			auto inserted = seen.emplace(component->getId(), component);
+			if (!inserted.second)
+			{
+				id_collision_ = true;
+				SimuCoreLogger::log("ERROR: ID collision: " + component->getFullName() + " and " +
+									inserted.first->second->getFullName() + " both have ID " +
+									std::to_string(component->getId()));
+			}
+			for (auto *sub : component->getSubComponents())
+				self(sub, self);
+		};
+		visit(root, visit);
+
+		rebuildIdIndex();
+		std::unordered_map<ComponentId, SignalBase *>().swap(signals_);
+		captureInitialState();
+		return !id_collision_;
 	}
 
+	bool isFrozen() const { return frozen_; }
+
+	// Double-buffered tick commit: outputs written during a tick only
+	// become visible to their inputs when commit() runs at the end of it.
+	// Switch only between ticks, when endTick() has committed everything.
+	void setDoubleBuffered(bool double_buffered) { double_buffered_ = double_buffered; }
+	bool isDoubleBuffered() const { return double_buffered_; }
+
+	// Number of completed ticks since start or the last reset
+	uint64_t getTick() const { return tick_; }
+
+	// Called once after the tick's consumers (telemetry, ...) have run.
+	// Commits first, so that stamps, histories and the snapshot all
+	// show the values the tick ended with, double-buffered or not.
+	void endTick()
+	{
+		commit();
+		for (auto *derived : derived_)
+		{
+			if (derived->hasReader())
+				derived->evaluateAtEndOfTick();
+		}
+		for (auto *history : history_list_)
+			history->record(tick_);
+		bool snapshot = snapshot_.isBuilt();
+		if (snapshot)
+			snapshot_.beginWrite();
+		for (auto index : changed_)
+		{
+			change_index_.stamp(static_cast<uint32_t>(index), tick_);
+			if (snapshot)
+				signals_by_index_[index]->writeSnapshot(snapshot_);
+		}
+		if (snapshot)
+			snapshot_.endWrite(tick_ + 1);
+		changed_.clear();
+		if (!forces_.empty())
+			expireForces();
+		++tick_;
+	}
+
+	// Publishes every value through a SignalSnapshot from now on, so
+	// other threads can read them while the tick loop runs
+	void enableSnapshots()
+	{
+		if (snapshot_.isBuilt())
+			return;
+		for (auto *signal : signals_by_index_)
+			signal->snapshot_offset_ = snapshot_.allocate(signal->getSnapshotSize());
+		snapshot_.build();
+		snapshot_.beginWrite();
+		for (auto *signal : signals_by_index_)
+			signal->writeSnapshot(snapshot_);
+		snapshot_.endWrite(tick_);
+		// Before the first tick the values are still those reset_signals() restores
+		if (tick_ == 0)
+			snapshot_.capture();
+	}
+
+	// Calls f(signal) for every signal whose last change was stamped at
+	// or after tick, most recent first. Costs one step per reported signal.
+	template <typename F>
+	void forEachChangedSince(uint64_t tick, F &&f) const
+	{
+		change_index_.forEachSince(tick, [&](uint32_t index)
+								   { f(signals_by_index_[index]); });
+	}
+
+	// Republishes the values changed since the last endTick() without
+	// ending the tick, e.g. after applying writes between ticks
+	void publishSnapshot()
+	{
+		if (!snapshot_.isBuilt())
+			return;
+		snapshot_.beginWrite();
+		for (auto index : changed_)
+			signals_by_index_[index]->writeSnapshot(snapshot_);
+		snapshot_.endWrite(tick_);
+	}
+
+	// Any thread: every value as of the last completed tick. The view
+	// is invalid, and signals fall back to their live value, until
+	// enableSnapshots() has run.
+	SnapshotView readSnapshot() const
+	{
+		SnapshotView snapshot;
+		snapshot_.read([&]
+					   { snapshot = snapshot_.copyAll(); });
+		return snapshot;
+	}
+
+	struct ChangedSignal
+	{
+		const SignalBase *signal;
+		uint64_t tick;
+		SnapshotView value;
+	};
+
+	// Any thread: the signals whose last change was stamped at or after
+	// tick, most recent first, with their values from the same snapshot.
+	// Copies only the reported signals. Returns the snapshot's tick.
+	uint64_t readChangesSince(uint64_t tick, std::vector<ChangedSignal> &changed) const
+	{
+		uint64_t snapshot_tick = 0;
+		auto collect = [&](bool copy_values)
+		{
+			snapshot_tick = copy_values ? snapshot_.getTick() : tick_;
+			changed.clear();
+			change_index_.forEachSince(tick, [&](uint32_t index)
+									   {
+				const SignalBase *signal = signals_by_index_[index];
+				SnapshotView value;
+				if (copy_values)
+					value = snapshot_.copy(signal->snapshot_offset_, SignalSnapshot::wordsFor(signal->getSnapshotSize()));
+				changed.push_back({signal, change_index_.lastChanged(index), std::move(value)}); });
+		};
+		if (!snapshot_.read([&]
+							{ collect(true); }))
+			collect(false);
+		return snapshot_tick;
+	}
+
+	// Any thread: has the tick thread bring every derived signal up to
+	// date and republish the snapshot, so that a snapshot read next
+	// shows derived signals that nothing reads every tick. Waits for
+	// serveDerivedRequests(), or at most derivedRequestTimeout.
+	void requestDerivedValues()
+	{
+		if (derived_.empty())
+			return;
+		std::unique_lock<std::mutex> lock(derived_requests_mutex_);
+		uint64_t request = ++derived_requested_;
+		derived_requests_pending_.store(true, std::memory_order_release);
+		derived_served_cv_.wait_for(lock, derivedRequestTimeout, [&]
+									{ return derived_served_ >= request; });
+	}
+
+	// Tick thread, between ticks: answers requestDerivedValues()
+	void serveDerivedRequests()
+	{
+		if (!derived_requests_pending_.exchange(false, std::memory_order_acquire))
+			return;
+		uint64_t requested;
+		{
+			std::lock_guard<std::mutex> lock(derived_requests_mutex_);
+			requested = derived_requested_;
+		}
+		for (auto *derived : derived_)
+			derived->evaluateOnDemand();
+		publishSnapshot();
+		{
+			std::lock_guard<std::mutex> lock(derived_requests_mutex_);
+			derived_served_ = requested;
+		}
+		derived_served_cv_.notify_all();
+	}
+
+	const SignalHistoryBase *findHistory(ComponentId id) const
+	{
+		auto it = histories_.find(id);
+		return (it != histories_.end()) ? it->second.get() : nullptr;
+	}
+
+	// Publishes the outputs buffered during this tick. endTick() does it
+	// too; call it earlier to let telemetry see them. Repeating is a no-op.
+	void commit()
+	{
+		if (!double_buffered_)
+			return;
+		auto &plan = PropagationPlan::getInstance();
+		if (plan.isCompiled())
+		{
+			plan.commitAll();
+			return;
+		}
+		for (auto *output : outputs_)
+			output->commit();
+	}
+
+	// Flattens every output's bindings into the PropagationPlan. Called
+	// after bindSignals(); calling it again rebuilds the plan.
+	const PropagationPlan &compilePropagationPlan()
+	{
+		auto &plan = PropagationPlan::getInstance();
+		plan.clear();
+		for (auto *output : outputs_)
+			output->compileBindings();
+		plan.setCompiled();
+		return plan;
+	}
+
+	// Returns every signal to its state at freeze(), i.e. after binding
+	// and before init(). Also releases every forced signal. Call it
+	// between ticks, when endTick() has committed any buffered writes.
 	void reset_signals() {
-		for (auto &p : signals_)
-			p.second->reset_signal();
+		releaseAll();
+		tick_ = 0;
+		for (auto *history : history_list_)
+			history->clear();
+		for (auto *derived : derived_)
+			derived->invalidate();
+		SignalStore::getInstance().resetAll();
+		initial_state_.restore();
+		// Signals the image does not cover (all of them before freeze()) are reset one by one
+		for (std::size_t i = captured_signals_; i < signals_by_index_.size(); ++i)
+			signals_by_index_[i]->reset_signal();
+		changed_.setAll(signals_by_index_.size());
+
+		bool snapshot = snapshot_.isBuilt();
+		if (snapshot)
+			snapshot_.beginWrite();
+		change_index_.restampAll(0);
+		if (snapshot)
+		{
+			if (snapshot_.hasCapture())
+				snapshot_.restore();
+			else
+				for (auto *signal : signals_by_index_)
+					signal->writeSnapshot(snapshot_);
+			snapshot_.endWrite(0);
+		}
 	}
 
 private:
+	friend class SimuCoreContext;
 	SignalRegistry() = default;
 	SignalRegistry(const SignalRegistry &) = delete;
 	SignalRegistry &operator=(const SignalRegistry &) = delete;
 
-	void add(SignalBase *signal) { signals_[signal->getId()] = signal; }
+	static SetValueResponse unknownResponse(ComponentId id)
+	{
+		return {SetValueByStringResult::UnsupportedType, "Unknown signal " + std::to_string(id)};
+	}
+
+	static SetValueResponse forcedResponse(ComponentId id)
+	{
+		return {SetValueByStringResult::ReadOnly, "Signal " + std::to_string(id) + " is forced"};
+	}
 
-	std::unordered_map<unsigned int, SignalBase *> signals_;
+	// Counts down forces with a tick limit, once the tick's commit is done
+	void expireForces()
+	{
+		for (std::size_t i = 0; i < forces_.size();)
+		{
+			Force &force = forces_[i];
+			if (force.ticks_remaining == 0 || --force.ticks_remaining != 0)
+			{
+				++i;
+				continue;
+			}
+			forced_.reset(force.index);
+			force = forces_.back();
+			forces_.pop_back();
+		}
+	}
+
+	SignalBase *lookup(ComponentId id) const
+	{
+		if (frozen_)
+		{
+			uint32_t index = id_index_.find(id);
+			return index != IdIndex::none ? signals_by_index_[index] : nullptr;
+		}
+		auto it = signals_.find(id);
+		return (it != signals_.end()) ? it->second : nullptr;
+	}
+
+	void rebuildIdIndex()
+	{
+		std::vector<ComponentId> ids;
+		ids.reserve(signals_by_index_.size());
+		for (auto *signal : signals_by_index_)
+			ids.push_back(signal->getId());
+		id_index_.build(ids);
+	}
+
+	void captureInitialState()
+	{
+		SignalStore::getInstance().captureAll();
+		initial_state_.clear();
+		for (auto *signal : signals_by_index_)
+			signal->captureState(initial_state_);
+		captured_signals_ = signals_by_index_.size();
+	}
+
+	void add(SignalBase *signal)
+	{
+		if (snapshot_.isBuilt())
+		{
+			// Network threads walk the snapshot layout and change index
+			// without locking, so neither can grow any more
+			SimuCoreLogger::log("ERROR: Signal " + signal->getFullName() +
+								" registered after snapshots were enabled, it is not registered");
+			return;
+		}
+		if (SignalBase *existing = lookup(signal->getId()))
+		{
+			// The first one keeps the ID; freeze() then reports the collision
+			id_collision_ = true;
+			SimuCoreLogger::log("ERROR: ID collision: " + signal->getFullName() + " and " + existing->getFullName() +
+								" both have ID " + std::to_string(signal->getId()) + ", the former is not registered");
+			return;
+		}
+		signal->index_ = static_cast<uint32_t>(signals_by_index_.size());
+		signals_by_index_.push_back(signal);
+		signals_by_type_[static_cast<std::size_t>(signal->getComponentType())].push_back(signal);
+		if (frozen_)
+		{
+			// Late signals still work, but each one costs a full rebuild
+			SimuCoreLogger::log("Signal " + signal->getFullName() + " registered after freeze, rebuilding the ID index");
+			rebuildIdIndex();
+		}
+		else
+			signals_[signal->getId()] = signal;
+		changed_.resize(signals_by_index_.size());
+		forced_.resize(signals_by_index_.size());
+		changed_.set(signal->index_);
+		change_index_.add(tick_);
+	}
+	void addOutput(SignalBase *output)
+	{
+		outputs_.push_back(output);
+		// Not in the plan yet, so commit through outputs_ until it is rebuilt
+		PropagationPlan::getInstance().clear();
+	}
+
+	void addHistory(ComponentId id, std::unique_ptr<SignalHistoryBase> history)
+	{
+		auto &slot = histories_[id];
+		if (!slot)
+			history_list_.push_back(history.get());
+		else
+			std::replace(history_list_.begin(), history_list_.end(), slot.get(), history.get());
+		slot = std::move(history);
+	}
+
+	// Used until freeze(), then replaced by id_index_
+	std::unordered_map<ComponentId, SignalBase *> signals_;
+	IdIndex id_index_;
+	std::vector<SignalBase *> signals_by_index_;
+	std::vector<SignalBase *> signals_by_type_[componentTypeCount];
+	std::vector<SignalBase *> outputs_;
+	std::vector<DerivedSignalBase *> derived_;
+	DirtyBitmap changed_;
+	ChangeIndex change_index_;
+	// Forced signals; forced_ is only tested while forces_ is not empty
+	struct Force
+	{
+		uint32_t index;
+		uint64_t ticks_remaining; // 0: until released
+	};
+	DirtyBitmap forced_;
+	std::vector<Force> forces_;
+	SignalSnapshot snapshot_;
+	// requestDerivedValues() from network threads; a tick thread that
+	// is busy elsewhere (or not running yet) only delays the reply
+	static constexpr std::chrono::seconds derivedRequestTimeout{1};
+	std::mutex derived_requests_mutex_;
+	std::condition_variable derived_served_cv_;
+	std::atomic<bool> derived_requests_pending_{false};
+	uint64_t derived_requested_ = 0;
+	uint64_t derived_served_ = 0;
+	std::unordered_map<ComponentId, std::unique_ptr<SignalHistoryBase>> histories_;
+	std::vector<SignalHistoryBase *> history_list_;
+	// What reset_signals() restores, captured by freeze()
+	SignalImage initial_state_;
+	std::size_t captured_signals_ = 0;
+	uint64_t tick_ = 0;
+	bool double_buffered_ = false;
+	bool frozen_ = false;
+	bool id_collision_ = false;
 
 	template <typename T>
 	friend class Signal;
+	template <typename T>
+	friend class OutputSignal;
+	template <typename T>
+	friend class InputSignal;
+	template <typename T>
+	friend class DerivedSignal;
+	template <typename S, typename T>
+	friend class BusField;
+	friend class SignalBase;
 };
 
 // ------------------------------------------------------------
-// Register signal implementation
+// Implementations that need the complete SignalRegistry
 // ------------------------------------------------------------
+inline bool SignalBase::valueHasChanged() const
+{
+	return isRegistered() && SignalRegistry::getInstance().getChangedSignals().test(index_);
+}
+
+inline uint64_t SignalBase::getLastChangedTick() const
+{
+	return isRegistered() ? SignalRegistry::getInstance().change_index_.lastChanged(index_) : 0;
+}
+
+inline bool SignalBase::isForced() const
+{
+	const auto &registry = SignalRegistry::getInstance();
+	return !registry.forces_.empty() && isRegistered() && registry.forced_.test(index_);
+}
+
+inline void SignalBase::markChanged() const
+{
+	if (isRegistered())
+		SignalRegistry::getInstance().changed_.set(index_);
+}
+
 template <typename T>
 void Signal<T>::registerSignal()
 {
 	SignalRegistry::getInstance().add(this);
 }
+
+template <typename T>
+void Signal<T>::addBusFields()
+{
+	forEachBusField<T>([&](std::size_t, const char *name, auto member)
+					   {
+		using Field = std::remove_reference_t<decltype(storage_.value().*member)>;
+		this->fields_.push_back(std::make_unique<BusField<T, Field>>(this, name, member)); });
+}
+
+template <typename S, typename T>
+void BusField<S, T>::registerSignal()
+{
+	SignalRegistry::getInstance().add(this);
+}
+
+template <typename T>
+void Signal<T>::enableHistory(std::size_t depth)
+{
+	SignalRegistry::getInstance().addHistory(this->getId(), std::make_unique<SignalHistory<Signal<T>>>(this, depth));
+}
+
+template <typename T>
+const T &Signal<T>::readIndirect() const
+{
+	if (this->read_mode_ == ReadMode::Aliased)
+		return static_cast<const InputSignal<T> *>(this)->source_->getValue();
+	this->evaluate();
+	return storage_.value();
+}
+
+template <typename T>
+OutputSignal<T>::OutputSignal(Component *owner, const std::string &name, const T &initial_value)
+	: Signal<T>(owner, name, ComponentType::INTERNAL_OUTPUT, initial_value)
+{
+	SignalRegistry::getInstance().addOutput(this);
+}
+
+template <typename T>
+void OutputSignal<T>::setValue(const T &value)
+{
+	if (SignalRegistry::getInstance().isDoubleBuffered())
+	{
+		next_value_ = value;
+		pending_commit_ = true;
+		return;
+	}
+	publish(value);
+}
+
+template <typename T>
+DerivedSignal<T>::DerivedSignal(Component *owner, const std::string &name, std::function<T()> compute,
+								std::vector<const SignalBase *> sources)
+	: OutputSignal<T>(owner, name), compute_(std::move(compute)), sources_(std::move(sources))
+{
+	this->read_mode_ = SignalBase::ReadMode::Derived;
+	SignalRegistry::getInstance().derived_.push_back(this);
+}
+
+template <typename T>
+bool DerivedSignal<T>::hasReader() const
+{
+	return this->hasBoundInputs() || SignalRegistry::getInstance().findHistory(this->getId());
+}
+
+template <typename T>
+void DerivedSignal<T>::refresh() const
+{
+	uint64_t tick = SignalRegistry::getInstance().getTick();
+	if (evaluated_)
+	{
+		if (evaluated_tick_ == tick && !evaluated_between_ticks_)
+			return;
+		evaluated_between_ticks_ = false;
+		// Stamped at or after the last computation, or changed during this tick
+		bool changed = false;
+		for (auto *source : sources_)
+		{
+			source->evaluate();
+			changed = changed || source->valueHasChanged() || source->getLastChangedTick() >= evaluated_tick_;
+		}
+		evaluated_tick_ = tick;
+		if (!changed)
+			return;
+	}
+	evaluated_ = true;
+	evaluated_tick_ = tick;
+	this->publish(compute_());
+}
+
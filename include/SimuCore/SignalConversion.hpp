@@ -0,0 +1,309 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <SimuCore/FixedString.hpp>
+#include <SimuCore/FixedVector.hpp>
+#include <SimuCore/Bus.hpp>
+#include <SimuCore/FixedPoint.hpp>
+
+// ------------------------------------------------------------
+// Array-valued signal types
+// ------------------------------------------------------------
+template <typename T>
+struct SignalArrayTraits
+{
+	static constexpr bool isArray = false;
+};
+
+template <typename T, std::size_t N>
+struct SignalArrayTraits<std::array<T, N>>
+{
+	static constexpr bool isArray = true;
+	static constexpr bool isResizable = false;
+	static constexpr std::size_t capacity = N;
+	using Element = T;
+};
+
+template <typename T, std::size_t N>
+struct SignalArrayTraits<FixedVector<T, N>>
+{
+	static constexpr bool isArray = true;
+	static constexpr bool isResizable = true;
+	static constexpr std::size_t capacity = N;
+	using Element = T;
+};
+
+// ------------------------------------------------------------
+// String conversion of signal values, used by the application
+// tree, telemetry and the websocket protocol. Arrays are written
+// compactly as "[1,2,3]" and buses as "{speed:1,torque:2}".
+// ------------------------------------------------------------
+namespace SignalConversion
+{
+	template <typename T>
+	constexpr bool isString = std::is_same_v<T, std::string> || IsFixedString<T>::value;
+
+	// Every integer width, signed and unsigned, plus float and double
+	template <typename T>
+	constexpr bool isNumber = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double>;
+
+	template <typename T>
+	constexpr bool isScalar = isNumber<T> || IsFixedPoint<T>::value || std::is_same_v<T, bool> || isString<T>;
+
+	template <typename T>
+	constexpr bool isSupported()
+	{
+		if constexpr (SignalArrayTraits<T>::isArray)
+			return isScalar<typename SignalArrayTraits<T>::Element> &&
+				   !isString<typename SignalArrayTraits<T>::Element>;
+		else
+			return isScalar<T>;
+	}
+
+	// Large enough for any integer and for shortest round-trip doubles
+	constexpr std::size_t numberBufferSize = 32;
+
+// Standard libraries without floating-point <charconv> (older embedded
+// toolchains) convert floats through streams in the classic locale.
+// Define SIMUCORE_PORTABLE_FLOAT_CONVERSION to use that path anyway,
+// e.g. to test it on a host.
+#if !defined(__cpp_lib_to_chars) || defined(SIMUCORE_PORTABLE_FLOAT_CONVERSION)
+#define SIMUCORE_STREAM_FLOAT_CONVERSION
+#endif
+
+	// Locale-independent; floating-point values use the shortest form
+	// that reads back to the same value
+	template <typename T>
+	char *numberToChars(char *first, char *last, T value)
+	{
+#ifdef SIMUCORE_STREAM_FLOAT_CONVERSION
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			std::ostringstream stream;
+			stream.imbue(std::locale::classic());
+			stream.precision(std::numeric_limits<T>::max_digits10);
+			stream << value;
+			const std::string text = stream.str();
+			std::size_t length = std::min(text.size(), static_cast<std::size_t>(last - first));
+			std::memcpy(first, text.data(), length);
+			return first + length;
+		}
+		else
+#endif
+			return std::to_chars(first, last, value).ptr;
+	}
+
+	template <typename T>
+	bool numberFromChars(const char *first, const char *last, T &value)
+	{
+		while (first < last && *first == ' ')
+			++first;
+		while (last > first && last[-1] == ' ')
+			--last;
+		// from_chars() takes no '+', so skip it, but only in front of a
+		// number: "+-5" and "+ 5" must still fail
+		if (last - first > 1 && *first == '+' && (std::isdigit(static_cast<unsigned char>(first[1])) || first[1] == '.'))
+			++first;
+#ifdef SIMUCORE_STREAM_FLOAT_CONVERSION
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			const std::string text(first, last);
+			// Streams do not read back what they write for these
+			if (text == "inf" || text == "-inf" || text == "nan" || text == "-nan")
+			{
+				value = text.back() == 'n' ? std::numeric_limits<T>::quiet_NaN()
+										   : (text[0] == '-' ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity());
+				return true;
+			}
+			std::istringstream stream(text);
+			stream.imbue(std::locale::classic());
+			T parsed;
+			if (text.empty() || !(stream >> parsed) || stream.peek() != std::char_traits<char>::eof())
+				return false;
+			value = parsed;
+			return true;
+		}
+		else
+#endif
+		{
+			auto result = std::from_chars(first, last, value);
+			return result.ec == std::errc() && result.ptr == last;
+		}
+	}
+
+	template <typename T>
+	void appendTo(std::string &text, const T &value)
+	{
+		if constexpr (isNumber<T>)
+		{
+			char buffer[numberBufferSize];
+			text.append(buffer, numberToChars(buffer, buffer + sizeof(buffer), value));
+		}
+		else if constexpr (IsFixedPoint<T>::value)
+		{
+			char buffer[T::bufferSize];
+			text.append(buffer, value.toChars(buffer, buffer + sizeof(buffer)));
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+			text += value ? "true" : "false";
+		else if constexpr (std::is_same_v<T, std::string>)
+			text += value;
+		else if constexpr (IsFixedString<T>::value)
+			text += value.view();
+		else if constexpr (isSupported<T>())
+		{
+			text += '[';
+			bool first = true;
+			for (const auto &element : value)
+			{
+				if (!first)
+					text += ',';
+				first = false;
+				appendTo(text, element);
+			}
+			text += ']';
+		}
+		else if constexpr (isBus<T>)
+		{
+			text += '{';
+			forEachBusField<T>([&](std::size_t index, const char *name, auto member)
+							   {
+				if (index)
+					text += ',';
+				text += name;
+				text += ':';
+				appendTo(text, value.*member); });
+			text += '}';
+		}
+		else
+			text += "Unsupported type";
+	}
+
+	template <typename T>
+	std::string toString(const T &value)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+			return value;
+		else
+		{
+			std::string text;
+			appendTo(text, value);
+			return text;
+		}
+	}
+
+	template <typename T>
+	bool arrayFromString(const std::string &text, T &value);
+
+	// Never throws; returns false if the text is not a valid T
+	template <typename T>
+	bool fromString(const std::string &text, T &value)
+	{
+		if constexpr (SignalArrayTraits<T>::isArray)
+			return isSupported<T>() && arrayFromString(text, value);
+		else if constexpr (isNumber<T>)
+			return numberFromChars(text.data(), text.data() + text.size(), value);
+		else if constexpr (IsFixedPoint<T>::value)
+			return T::fromChars(text.data(), text.data() + text.size(), value);
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			if (text == "true" || text == "1")
+				value = true;
+			else if (text == "false" || text == "0")
+				value = false;
+			else
+				return false;
+			return true;
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			value = text;
+			return true;
+		}
+		else if constexpr (IsFixedString<T>::value)
+			return value.assign(text);
+		else
+			return false;
+	}
+
+	// Splits "[a, b, c]" into its elements. "[]" has none; an empty
+	// element, as in "[1,,2]" or "[1,]", makes the text invalid.
+	inline bool splitArray(const std::string &text, std::vector<std::string> &elements)
+	{
+		std::size_t begin = text.find_first_not_of(' ');
+		std::size_t end = text.find_last_not_of(' ');
+		if (begin == std::string::npos || begin == end || text[begin] != '[' || text[end] != ']')
+			return false;
+		if (text.find_first_not_of(' ', begin + 1) == end)
+			return true;
+		std::size_t position = begin + 1;
+		while (true)
+		{
+			std::size_t comma = text.find(',', position);
+			if (comma == std::string::npos || comma > end)
+				comma = end;
+			std::size_t first = text.find_first_not_of(' ', position);
+			if (first >= comma)
+				return false;
+			std::size_t last = text.find_last_not_of(' ', comma - 1);
+			elements.push_back(text.substr(first, last - first + 1));
+			if (comma == end)
+				return true;
+			position = comma + 1;
+		}
+	}
+
+	// Writes elements [offset, offset + elements.size()) of an array value.
+	// Resizable arrays grow to fit, within their capacity.
+	template <typename T>
+	bool elementsFromStrings(std::size_t offset, const std::vector<std::string> &elements, T &value)
+	{
+		if constexpr (isSupported<T>() && SignalArrayTraits<T>::isArray)
+		{
+			using Traits = SignalArrayTraits<T>;
+			// offset comes from the client: compare without adding, which could wrap
+			if (offset > Traits::capacity || elements.size() > Traits::capacity - offset)
+				return false;
+			std::size_t end = offset + elements.size();
+			if constexpr (Traits::isResizable)
+			{
+				if (end > value.size())
+					value.resize(end);
+			}
+			for (std::size_t i = 0; i < elements.size(); ++i)
+			{
+				if (!fromString(elements[i], value[offset + i]))
+					return false;
+			}
+			return true;
+		}
+		else
+			return false;
+	}
+
+	template <typename T>
+	bool arrayFromString(const std::string &text, T &value)
+	{
+		std::vector<std::string> elements;
+		if (!splitArray(text, elements))
+			return false;
+		if constexpr (SignalArrayTraits<T>::isResizable)
+			value.clear();
+		else if (elements.size() != SignalArrayTraits<T>::capacity)
+			return false;
+		return elementsFromStrings(0, elements, value);
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <SimuCore/SignalConversion.hpp>
+
+// ------------------------------------------------------------
+// Fixed-depth ring buffer of (tick, value) samples for one signal,
+// filled by the SignalRegistry at the end of every tick. Recording
+// copies the value only; formatting happens when it is fetched.
+// Tick thread only: GET_HISTORY is answered there too.
+// ------------------------------------------------------------
+class SignalHistoryBase
+{
+public:
+	virtual ~SignalHistoryBase() = default;
+	virtual void record(uint64_t tick) = 0;
+	virtual void clear() = 0;
+	// Oldest sample first
+	virtual void getSamples(std::vector<uint64_t> &ticks, std::vector<std::string> &values) const = 0;
+};
+
+template <typename SignalType>
+class SignalHistory : public SignalHistoryBase
+{
+public:
+	using ValueType = std::decay_t<decltype(std::declval<const SignalType &>().getValue())>;
+
+	SignalHistory(const SignalType *signal, std::size_t depth)
+		: signal_(signal), values_(depth ? depth : 1), ticks_(depth ? depth : 1) {}
+
+	void record(uint64_t tick) override
+	{
+		values_[head_] = signal_->getValue();
+		ticks_[head_] = tick;
+		head_ = (head_ + 1) % values_.size();
+		if (count_ < values_.size())
+			++count_;
+	}
+
+	void clear() override
+	{
+		head_ = 0;
+		count_ = 0;
+	}
+
+	void getSamples(std::vector<uint64_t> &ticks, std::vector<std::string> &values) const override
+	{
+		ticks.reserve(ticks.size() + count_);
+		values.reserve(values.size() + count_);
+		std::size_t oldest = (head_ + values_.size() - count_) % values_.size();
+		for (std::size_t i = 0; i < count_; ++i)
+		{
+			std::size_t slot = (oldest + i) % values_.size();
+			ticks.push_back(ticks_[slot]);
+			values.push_back(SignalConversion::toString(static_cast<const ValueType &>(values_[slot])));
+		}
+	}
+
+private:
+	const SignalType *signal_;
+	std::vector<ValueType> values_;
+	std::vector<uint64_t> ticks_;
+	std::size_t head_ = 0;
+	std::size_t count_ = 0;
+};
@@ -0,0 +1,250 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <SimuCore/FixedString.hpp>
+#include <SimuCore/FixedVector.hpp>
+
+// ------------------------------------------------------------
+// Seqlock-published copy of every signal value
+//
+// At the end of each tick the tick thread writes the values that
+// changed into a word array, between two increments of a sequence
+// counter. Network threads copy the whole array and retry if the
+// counter was odd or moved while they copied. They always see the
+// values of one completed tick, and the tick loop never waits for
+// them.
+//
+// Words are written with release stores and read with acquire
+// loads (plain moves on x86). A reader that sees any word of a
+// write therefore also sees that write's odd sequence number when
+// it checks again, and no fences are needed: ThreadSanitizer cannot
+// model fences, but it does check this.
+// ------------------------------------------------------------
+class SeqLock
+{
+public:
+	void beginWrite() { sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+	void endWrite() { sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+	uint32_t beginRead() const
+	{
+		uint32_t sequence;
+		while ((sequence = sequence_.load(std::memory_order_acquire)) & 1)
+		{
+		}
+		return sequence;
+	}
+
+	// True if a write overlapped the read started with beginRead().
+	// The reads in between must be acquire loads.
+	bool retryRead(uint32_t sequence) const { return sequence_.load(std::memory_order_acquire) != sequence; }
+
+private:
+	std::atomic<uint32_t> sequence_{0};
+};
+
+// How a value type is held in the snapshot: something trivially
+// copyable that the value can be rebuilt from
+template <typename T, typename = void>
+struct SnapshotTraits
+{
+	using Stored = T;
+	static Stored store(const T &value) { return value; }
+	static T load(const Stored &stored) { return stored; }
+	static bool truncated(const Stored &) { return false; }
+};
+
+// Types without a representation are reported with their default value
+template <typename T>
+struct SnapshotTraits<T, std::enable_if_t<!std::is_trivially_copyable_v<T>>>
+{
+	using Stored = bool;
+	static Stored store(const T &) { return false; }
+	static T load(const Stored &) { return T{}; }
+	static bool truncated(const Stored &) { return false; }
+};
+
+// Snapshot slots are sized once, when snapshots are enabled, so
+// std::string values are stored in a fixed 255-byte slot. Anything
+// read from a snapshot (APPLICATION_TREE, GET_CHANGES, ...) shows
+// only the first 255 bytes of a longer string, and the reply marks
+// it "truncated"; the signal itself and getValueAsString() without
+// a snapshot keep the whole value.
+constexpr std::size_t snapshotStringCapacity = 255;
+
+template <>
+struct SnapshotTraits<std::string>
+{
+	struct Stored
+	{
+		FixedString<snapshotStringCapacity> text;
+		bool truncated;
+	};
+	static Stored store(const std::string &value)
+	{
+		Stored stored{};
+		stored.truncated = !stored.text.assign(value);
+		return stored;
+	}
+	static std::string load(const Stored &stored) { return stored.text.str(); }
+	static bool truncated(const Stored &stored) { return stored.truncated; }
+};
+
+template <typename T, std::size_t N>
+struct SnapshotTraits<FixedVector<T, N>>
+{
+	struct Stored
+	{
+		std::array<T, N> elements;
+		std::size_t size;
+	};
+	static Stored store(const FixedVector<T, N> &value)
+	{
+		Stored stored{};
+		std::copy(value.begin(), value.end(), stored.elements.begin());
+		stored.size = value.size();
+		return stored;
+	}
+	static FixedVector<T, N> load(const Stored &stored)
+	{
+		FixedVector<T, N> value;
+		for (std::size_t i = 0; i < stored.size; ++i)
+			value.push_back(stored.elements[i]);
+		return value;
+	}
+	static bool truncated(const Stored &) { return false; }
+};
+
+// A reader's private copy of all or part of the snapshot
+class SnapshotView
+{
+public:
+	bool isValid() const { return !words_.empty(); }
+	uint64_t getTick() const { return tick_; }
+
+	template <typename Stored>
+	Stored read(uint32_t offset) const
+	{
+		Stored stored;
+		std::memcpy(static_cast<void *>(&stored), words_.data() + (offset - first_), sizeof(Stored));
+		return stored;
+	}
+
+private:
+	std::vector<uint64_t> words_;
+	uint32_t first_ = 0;
+	uint64_t tick_ = 0;
+
+	friend class SignalSnapshot;
+};
+
+class SignalSnapshot
+{
+public:
+	static constexpr std::size_t wordsFor(std::size_t bytes) { return (bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t); }
+
+	// Reserves room for a value of the given size; returns its word offset
+	uint32_t allocate(std::size_t bytes)
+	{
+		uint32_t offset = static_cast<uint32_t>(size_);
+		size_ += wordsFor(bytes);
+		return offset;
+	}
+
+	// Creates the word array once every value has been allocated
+	void build()
+	{
+		words_.reset(new std::atomic<uint64_t>[size_]);
+		for (std::size_t i = 0; i < size_; ++i)
+			words_[i].store(0, std::memory_order_relaxed);
+		built_.store(true, std::memory_order_release);
+	}
+
+	bool isBuilt() const { return built_.load(std::memory_order_acquire); }
+
+	// Tick thread only
+	void beginWrite() { lock_.beginWrite(); }
+	void endWrite(uint64_t tick)
+	{
+		tick_.store(tick, std::memory_order_release);
+		lock_.endWrite();
+	}
+
+	template <typename Stored>
+	void write(uint32_t offset, const Stored &stored)
+	{
+		static_assert(std::is_trivially_copyable_v<Stored>);
+		uint64_t words[wordsFor(sizeof(Stored))] = {};
+		std::memcpy(words, &stored, sizeof(Stored));
+		for (std::size_t i = 0; i < wordsFor(sizeof(Stored)); ++i)
+			words_[offset + i].store(words[i], std::memory_order_release);
+	}
+
+	// Any thread. Runs f until it completes without overlapping a
+	// write, so everything f copies belongs to the same tick. f should
+	// only copy (see copy()); it may run more than once. Returns false,
+	// without running f, if build() has not run yet.
+	template <typename F>
+	bool read(F &&f) const
+	{
+		if (!isBuilt())
+			return false;
+		uint32_t sequence;
+		do
+		{
+			sequence = lock_.beginRead();
+			f();
+		} while (lock_.retryRead(sequence));
+		return true;
+	}
+
+	// Inside read(): copies the words [first, first + count)
+	SnapshotView copy(uint32_t first, std::size_t count) const
+	{
+		SnapshotView view;
+		view.words_.resize(count);
+		view.first_ = first;
+		for (std::size_t i = 0; i < count; ++i)
+			view.words_[i] = words_[first + i].load(std::memory_order_acquire);
+		view.tick_ = tick_.load(std::memory_order_acquire);
+		return view;
+	}
+
+	SnapshotView copyAll() const { return copy(0, size_); }
+
+	// Tick thread only: keeps a copy of every word for restore()
+	void capture()
+	{
+		captured_.resize(size_);
+		for (std::size_t i = 0; i < size_; ++i)
+			captured_[i] = words_[i].load(std::memory_order_relaxed);
+	}
+	bool hasCapture() const { return !captured_.empty(); }
+
+	// Inside a write section: puts the words kept by capture() back
+	void restore()
+	{
+		for (std::size_t i = 0; i < captured_.size(); ++i)
+			words_[i].store(captured_[i], std::memory_order_release);
+	}
+
+	// Inside read(): the number of completed ticks the snapshot holds
+	uint64_t getTick() const { return tick_.load(std::memory_order_acquire); }
+
+private:
+	SeqLock lock_;
+	std::unique_ptr<std::atomic<uint64_t>[]> words_;
+	std::size_t size_ = 0;
+	std::vector<uint64_t> captured_;
+	std::atomic<uint64_t> tick_{0};
+	std::atomic<bool> built_{false};
+};
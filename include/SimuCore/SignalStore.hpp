@@ -0,0 +1,282 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <SimuCore/SimuCoreContext.hpp>
+
+// ------------------------------------------------------------
+// Signal value storage
+//
+// By default every Signal<T> keeps its value and initial value
+// inline. Building with SIMUCORE_POOLED_SIGNALS moves them into
+// contiguous per-type pools (one array of double, one of int, ...)
+// and Signal<T> only keeps a slot index.
+//
+// What that buys is smaller signal objects and a reset that copies
+// each pool's reset image in one go. It does not make the tick stream
+// through the pools: components still run object by object and read
+// their signals one at a time, and each read adds a pool lookup. In
+// the large_model benchmark on an x86-64 machine, reset was about 2.5x
+// faster and execute about 5-10% slower than with inline storage.
+//
+// So pooling is for models that reset often, or where signal object
+// size matters. It is not recommended for execute-bound models; keep
+// the default inline storage for those.
+// ------------------------------------------------------------
+
+// Growable contiguous array. Unlike std::vector it also hands out
+// real references for bool.
+template <typename T>
+class DenseArray
+{
+public:
+	std::size_t size() const { return size_; }
+	T *data() { return data_.get(); }
+	const T *data() const { return data_.get(); }
+	T &operator[](std::size_t i) { return data_[i]; }
+	const T &operator[](std::size_t i) const { return data_[i]; }
+
+	void push_back(const T &value)
+	{
+		if (size_ == capacity_)
+		{
+			std::size_t capacity = capacity_ ? capacity_ * 2 : 64;
+			std::unique_ptr<T[]> data(new T[capacity]);
+			for (std::size_t i = 0; i < size_; ++i)
+				data[i] = std::move(data_[i]);
+			data_ = std::move(data);
+			capacity_ = capacity;
+		}
+		data_[size_++] = value;
+	}
+
+	void assign(const DenseArray &other)
+	{
+		for (std::size_t i = 0; i < size_; ++i)
+			data_[i] = other.data_[i];
+	}
+
+private:
+	std::unique_ptr<T[]> data_;
+	std::size_t size_ = 0;
+	std::size_t capacity_ = 0;
+};
+
+class SignalPoolBase
+{
+public:
+	virtual ~SignalPoolBase() = default;
+	virtual void resetAll() = 0;
+	virtual void captureAll() = 0;
+	virtual std::size_t size() const = 0;
+	virtual std::size_t bytesPerSlot() const = 0;
+};
+
+// Every pool that has been instantiated, so the pools can be
+// walked (and measured) without knowing their value types.
+class SignalStore
+{
+public:
+	static SignalStore &getInstance() { return SimuCoreContext::active<SignalStore>(); }
+
+	void addPool(SignalPoolBase *pool) { pools_.push_back(pool); }
+	const std::vector<SignalPoolBase *> &getPools() const { return pools_; }
+
+	void resetAll()
+	{
+		for (auto *pool : pools_)
+			pool->resetAll();
+	}
+
+	// Makes the current values the ones resetAll() restores
+	void captureAll()
+	{
+		for (auto *pool : pools_)
+			pool->captureAll();
+	}
+
+private:
+	friend class SimuCoreContext;
+	SignalStore() = default;
+	SignalStore(const SignalStore &) = delete;
+	SignalStore &operator=(const SignalStore &) = delete;
+
+	std::vector<SignalPoolBase *> pools_;
+};
+
+template <typename T>
+class SignalPool : public SignalPoolBase
+{
+public:
+#ifdef SIMUCORE_MULTI_INSTANCE
+	static SignalPool &getInstance() { return SimuCoreContext::active<SignalPool>(); }
+#else
+	// Constant-initialized, so handles pay no guard check per access
+	static SignalPool &getInstance() { return instance_; }
+#endif
+
+	uint32_t allocate(const T &initial_value)
+	{
+		if (values_.size() == 0)
+			SignalStore::getInstance().addPool(this);
+		values_.push_back(initial_value);
+		initial_values_.push_back(initial_value);
+		reset_values_.push_back(initial_value);
+		return static_cast<uint32_t>(values_.size() - 1);
+	}
+
+	T &value(uint32_t slot) { return values_[slot]; }
+	const T &initialValue(uint32_t slot) const { return initial_values_[slot]; }
+
+	const T *values() const { return values_.data(); }
+	std::size_t size() const override { return values_.size(); }
+	std::size_t bytesPerSlot() const override { return 3 * sizeof(T); }
+
+	void resetAll() override
+	{
+		values_.assign(reset_values_);
+	}
+
+	void captureAll() override
+	{
+		reset_values_.assign(values_);
+	}
+
+private:
+	friend class SimuCoreContext;
+	constexpr SignalPool() = default;
+	SignalPool(const SignalPool &) = delete;
+	SignalPool &operator=(const SignalPool &) = delete;
+
+	DenseArray<T> values_;
+	// What the signals were constructed with, as with inline storage
+	DenseArray<T> initial_values_;
+	// What resetAll() restores: the values at captureAll(), i.e. after
+	// binding, or the initial value for slots allocated since
+	DenseArray<T> reset_values_;
+
+#ifndef SIMUCORE_MULTI_INSTANCE
+	static SignalPool instance_;
+#endif
+};
+
+#ifndef SIMUCORE_MULTI_INSTANCE
+template <typename T>
+SignalPool<T> SignalPool<T>::instance_;
+#endif
+
+// ------------------------------------------------------------
+// Byte image of state scattered over many objects (inline signal
+// values, deadband references, ...). add() copies a variable into
+// one contiguous buffer and restore() copies every variable back,
+// so a reset is a single memcpy pass rather than a virtual call per
+// signal. Types that are not trivially copyable keep a typed copy.
+// ------------------------------------------------------------
+class SignalImage
+{
+public:
+	template <typename T>
+	void add(T &variable)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			entries_.push_back({&variable, bytes_.size(), sizeof(T)});
+			const auto *bytes = reinterpret_cast<const unsigned char *>(&variable);
+			bytes_.insert(bytes_.end(), bytes, bytes + sizeof(T));
+		}
+		else
+			copies_.push_back(std::make_unique<Copy<T>>(variable));
+	}
+
+	void restore()
+	{
+		for (const auto &entry : entries_)
+			std::memcpy(entry.variable, bytes_.data() + entry.offset, entry.size);
+		for (const auto &copy : copies_)
+			copy->restore();
+	}
+
+	void clear()
+	{
+		entries_.clear();
+		bytes_.clear();
+		copies_.clear();
+	}
+
+	std::size_t size() const { return bytes_.size(); }
+
+private:
+	struct Entry
+	{
+		void *variable;
+		std::size_t offset;
+		std::size_t size;
+	};
+
+	struct CopyBase
+	{
+		virtual ~CopyBase() = default;
+		virtual void restore() = 0;
+	};
+
+	template <typename T>
+	struct Copy : CopyBase
+	{
+		explicit Copy(T &variable) : variable(variable), value(variable) {}
+		void restore() override { variable = value; }
+		T &variable;
+		T value;
+	};
+
+	std::vector<Entry> entries_;
+	std::vector<unsigned char> bytes_;
+	std::vector<std::unique_ptr<CopyBase>> copies_;
+};
+
+#ifdef SIMUCORE_POOLED_SIGNALS
+
+// Thin handle into SignalPool<T>
+template <typename T>
+class SignalValueStorage
+{
+public:
+	explicit SignalValueStorage(const T &initial_value)
+		: slot_(SignalPool<T>::getInstance().allocate(initial_value)) {}
+
+	T &value() { return SignalPool<T>::getInstance().value(slot_); }
+	const T &value() const { return SignalPool<T>::getInstance().value(slot_); }
+	const T &initialValue() const { return SignalPool<T>::getInstance().initialValue(slot_); }
+	uint32_t slot() const { return slot_; }
+
+	// The pool captures and restores its values itself
+	void capture(SignalImage &) {}
+
+private:
+	uint32_t slot_;
+};
+
+#else
+
+template <typename T>
+class SignalValueStorage
+{
+public:
+	explicit SignalValueStorage(const T &initial_value)
+		: value_(initial_value), initial_value_(initial_value) {}
+
+	T &value() { return value_; }
+	const T &value() const { return value_; }
+	const T &initialValue() const { return initial_value_; }
+
+	void capture(SignalImage &image) { image.add(value_); }
+
+private:
+	T value_;
+	T initial_value_;
+};
+
+#endif
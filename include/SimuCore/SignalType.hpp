@@ -0,0 +1,205 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <SimuCore/FixedString.hpp>
+#include <SimuCore/FixedVector.hpp>
+#include <SimuCore/Bus.hpp>
+#include <SimuCore/FixedPoint.hpp>
+
+// ------------------------------------------------------------
+// Compile-time type tags and names for signal value types. Used
+// instead of typeid so type dispatch and the application tree need
+// neither RTTI nor an allocation per lookup. Every integer width
+// and signedness has a tag of its own.
+// ------------------------------------------------------------
+enum class SignalType : uint8_t
+{
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+	Bool,
+	String,
+	FixedString,
+	Array,
+	FixedVector,
+	Bus,
+	FixedPoint,
+	Unsupported
+};
+
+// Indexed by SignalType. Composite types extend theirs, see below.
+inline constexpr const char *signalTypeNames[] = {
+	"int8", "int16", "int32", "int64",
+	"uint8", "uint16", "uint32", "uint64",
+	"float", "double", "bool", "string",
+	"FixedString", "array", "FixedVector", "bus", "fixedpoint", "unsupported"};
+
+static_assert(sizeof(signalTypeNames) / sizeof(signalTypeNames[0]) == static_cast<std::size_t>(SignalType::Unsupported) + 1,
+			  "signalTypeNames must have one entry per SignalType");
+
+constexpr const char *signalTypeName(SignalType type) { return signalTypeNames[static_cast<std::size_t>(type)]; }
+
+// NUL-terminated name of N characters, built at compile time
+template <std::size_t N>
+struct TypeName
+{
+	char chars[N + 1] = {};
+};
+
+template <std::size_t A, std::size_t B>
+constexpr TypeName<A + B> operator+(const TypeName<A> &a, const TypeName<B> &b)
+{
+	TypeName<A + B> name;
+	for (std::size_t i = 0; i < A; ++i)
+		name.chars[i] = a.chars[i];
+	for (std::size_t i = 0; i < B; ++i)
+		name.chars[A + i] = b.chars[i];
+	return name;
+}
+
+constexpr std::size_t nameLength(const char *text)
+{
+	std::size_t length = 0;
+	while (text[length])
+		++length;
+	return length;
+}
+
+template <std::size_t N>
+constexpr TypeName<N - 1> typeNameOf(const char (&text)[N])
+{
+	TypeName<N - 1> name;
+	for (std::size_t i = 0; i + 1 < N; ++i)
+		name.chars[i] = text[i];
+	return name;
+}
+
+constexpr std::size_t digitCount(std::size_t value) { return value < 10 ? 1 : 1 + digitCount(value / 10); }
+
+template <std::size_t Value>
+constexpr TypeName<digitCount(Value)> typeNameOf()
+{
+	TypeName<digitCount(Value)> name;
+	std::size_t value = Value;
+	for (std::size_t i = digitCount(Value); i > 0; --i, value /= 10)
+		name.chars[i - 1] = static_cast<char>('0' + value % 10);
+	return name;
+}
+
+template <typename T, typename = void>
+struct SignalTypeInfo;
+
+// The name of value type T as a TypeName, for composing
+template <typename T>
+constexpr auto typeNameOf()
+{
+	constexpr const char *text = SignalTypeInfo<T>::name();
+	TypeName<nameLength(text)> name;
+	for (std::size_t i = 0; i < nameLength(text); ++i)
+		name.chars[i] = text[i];
+	return name;
+}
+
+template <typename T, typename>
+struct SignalTypeInfo
+{
+	static constexpr SignalType tag = SignalType::Unsupported;
+	static constexpr const char *name() { return signalTypeName(tag); }
+};
+
+// Every integer width, named "int8" ... "uint64"
+template <typename T>
+struct SignalTypeInfo<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+{
+	static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported integer width");
+	static constexpr SignalType tag = static_cast<SignalType>(
+		(std::is_signed_v<T> ? static_cast<int>(SignalType::Int8) : static_cast<int>(SignalType::UInt8)) +
+		(sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3));
+	static constexpr const char *name() { return signalTypeName(tag); }
+};
+
+template <>
+struct SignalTypeInfo<float>
+{
+	static constexpr SignalType tag = SignalType::Float;
+	static constexpr const char *name() { return signalTypeName(tag); }
+};
+
+template <>
+struct SignalTypeInfo<double>
+{
+	static constexpr SignalType tag = SignalType::Double;
+	static constexpr const char *name() { return signalTypeName(tag); }
+};
+
+template <>
+struct SignalTypeInfo<bool>
+{
+	static constexpr SignalType tag = SignalType::Bool;
+	static constexpr const char *name() { return signalTypeName(tag); }
+};
+
+template <>
+struct SignalTypeInfo<std::string>
+{
+	static constexpr SignalType tag = SignalType::String;
+	static constexpr const char *name() { return signalTypeName(tag); }
+};
+
+// Composite names are composed at compile time, once per type
+template <std::size_t N>
+struct SignalTypeInfo<FixedString<N>>
+{
+	static constexpr SignalType tag = SignalType::FixedString;
+	static constexpr auto text = typeNameOf("FixedString<") + typeNameOf<N>() + typeNameOf(">");
+	static constexpr const char *name() { return text.chars; }
+};
+
+template <typename T, std::size_t N>
+struct SignalTypeInfo<std::array<T, N>>
+{
+	static constexpr SignalType tag = SignalType::Array;
+	static constexpr auto text = typeNameOf<T>() + typeNameOf("[") + typeNameOf<N>() + typeNameOf("]");
+	static constexpr const char *name() { return text.chars; }
+};
+
+template <typename T, std::size_t N>
+struct SignalTypeInfo<FixedVector<T, N>>
+{
+	static constexpr SignalType tag = SignalType::FixedVector;
+	static constexpr auto text = typeNameOf("FixedVector<") + typeNameOf<T>() + typeNameOf(",") + typeNameOf<N>() + typeNameOf(">");
+	static constexpr const char *name() { return text.chars; }
+};
+
+// "Q15", "Q31" or "Q3.12"
+template <int IntegerBits, int FractionalBits>
+struct SignalTypeInfo<FixedPoint<IntegerBits, FractionalBits>>
+{
+	static constexpr SignalType tag = SignalType::FixedPoint;
+	static constexpr auto integerPart()
+	{
+		if constexpr (IntegerBits == 0)
+			return TypeName<0>{};
+		else
+			return typeNameOf<static_cast<std::size_t>(IntegerBits)>() + typeNameOf(".");
+	}
+	static constexpr auto text = typeNameOf("Q") + integerPart() + typeNameOf<static_cast<std::size_t>(FractionalBits)>();
+	static constexpr const char *name() { return text.chars; }
+};
+
+template <typename T>
+struct SignalTypeInfo<T, std::enable_if_t<isBus<T>>>
+{
+	static constexpr SignalType tag = SignalType::Bus;
+	static constexpr const char *name() { return signalTypeName(tag); }
+};
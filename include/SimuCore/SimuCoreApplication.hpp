@@ -12,16 +12,52 @@
 #include <SimuCore/NoImplementationWebsocketServer.hpp>
 #include <SimuCore/generated/Communication.hpp>
 #include <SimuCore/ApplicationTree.hpp>
+#include <SimuCore/PathIndex.hpp>
 #include <SimuCore/json.hpp>
+#include <SimuCore/MpscQueue.hpp>
 #include <memory>
 #include <string>
 #include <atomic>
+#include <mutex>
 
 void to_json(nlohmann::json &j, SignalBase *signal);
 
 struct SimulationSystem {
     std::atomic<bool> is_simulating{false};
     std::atomic<int> ticks_remaining{0};
+    // Client waiting for a START_SIMULATION reset, or -1
+    std::atomic<int> reset_requested_by{-1};
+};
+
+enum class SignalWriteKind {
+    Value,      // UPDATE_PHYSICAL_INPUT
+    Elements,   // UPDATE_ELEMENTS: element range starting at offset
+    Force,      // FORCE: for ticks ticks, or until released if 0
+    Release,    // RELEASE
+    ReleaseAll  // RELEASE with release_all
+};
+
+// A signal write received from a client
+struct SignalWrite {
+    ComponentId id;
+    SignalWriteKind kind;
+    std::size_t offset;
+    std::vector<std::string> values;
+    std::uint64_t ticks;
+};
+
+// The writes of one message. Queued by the network thread, applied
+// and answered by the tick thread before its next executeAll().
+struct InboundWrites {
+    int client_id;
+    std::vector<SignalWrite> writes;
+};
+
+// A GET_HISTORY request. Histories are written by endTick(), so
+// they are read and answered on the tick thread as well.
+struct HistoryRequest {
+    int client_id;
+    std::vector<ComponentId> ids;
 };
 
 class SimuCoreApplication : public Component
@@ -29,10 +65,18 @@ class SimuCoreApplication : public Component
 public:
 	SimuCoreApplication(const std::string &applicationName);
 
-	void initApp();
+	// Binds, indexes and initialises the application. Returns false, and
+	// leaves it stopped, if two components or signals share an ID.
+	bool initApp();
 	void run();
+	// One tick without pacing or telemetry, for hosts that drive the
+	// application themselves (SimuCoreHost)
+	void step();
 	virtual void bindSignals() = 0;
 
+	// The context this application was built in
+	SimuCoreContext &getContext() const { return context_; }
+
 protected:
 	void sendSignalValuesToWebsockets();
 
@@ -40,18 +84,30 @@ private:
 	void on_connection(int clientId, bool connected);
 	void on_message(int clientId, const std::string &message);
 	void reset_system();
+	void queueWrites(InboundWrites writes);
+	void applyInboundWrites();
+	void answerHistoryRequests();
+	void applyTickMode();
 	void init() override;
 	void execute() override;
 
+	// Activated by every entry point, tick and network threads alike
+	SimuCoreContext &context_;
 	std::unique_ptr<SimuCoreHAL> hal;
 	std::unique_ptr<SimuCoreTick> simu_core_tick;
 	std::unique_ptr<SimuCoreWebsocketServer> websocket_server_;
+	// Shared with the network threads; the tick loop only ever try_locks it
+	std::mutex subscriptions_mutex_;
 	std::vector<SimuCore::SubscribePayload> subscriptions;
-	bool has_been_initialized = false;
-	int _up_time_in_milli_seconds = 0;
+	std::atomic<bool> refresh_all_subscriptions_{false};
+	// Set by a successful initApp(); run() and step() do nothing until then
+	std::atomic<bool> has_been_initialized{false};
+	std::atomic<int> _up_time_in_milli_seconds{0};
+	MpscQueue<InboundWrites, 64> inbound_writes_;
+	std::vector<InboundWrites> inbound_batch_;
+	MpscQueue<HistoryRequest, 64> history_requests_;
 	ApplicationTree _applicationTree;
-	nlohmann::json _initialApplicationTreeJson;
-	nlohmann::json _applicationTreeJson;
+	PathIndex _pathIndex;
 	
 	SimulationSystem simulation_system = {.is_simulating = false, .ticks_remaining = 0};
 };
@@ -0,0 +1,231 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <SimuCore/SimuCoreLogger.hpp>
+
+// ------------------------------------------------------------
+// Per-instance home of the framework's singletons
+//
+// SignalRegistry, ComponentTable, PropagationPlan, the per-type
+// propagation tables and pools and the generated Config all live
+// in a context. By default there is only the default context and
+// getInstance() costs what a plain singleton does.
+//
+// Building with SIMUCORE_MULTI_INSTANCE resolves getInstance()
+// through the thread's active context instead, so one process can
+// host several applications. Build each one in its own context and
+// activate that context (Scope) on every thread that touches it;
+// SimuCoreApplication does the latter itself and SimuCoreHost does
+// both. Every signal access then pays a few thread-local loads.
+//
+// Each singleton type takes one of a context's slots, and there is
+// one propagation table and one pool per signal value type, so every
+// distinct FixedString<N>, array width or bus adds to the count.
+// SIMUCORE_MAX_CONTEXT_SLOTS (default 256) sets how many there are;
+// running out logs an error and aborts.
+// ------------------------------------------------------------
+class SimuCoreContext
+{
+public:
+	SimuCoreContext() : serial_(nextSerial()) {}
+	SimuCoreContext(const SimuCoreContext &) = delete;
+	SimuCoreContext &operator=(const SimuCoreContext &) = delete;
+
+	~SimuCoreContext()
+	{
+		while (!created_.empty())
+			created_.pop_back();
+	}
+
+	static SimuCoreContext &current()
+	{
+#ifdef SIMUCORE_MULTI_INSTANCE
+		SimuCoreContext *context = current_;
+		return context ? *context : getDefault();
+#else
+		return getDefault();
+#endif
+	}
+
+	// Never destroyed, so statics may use it until the process exits
+	static SimuCoreContext &getDefault()
+	{
+		static SimuCoreContext *context = new SimuCoreContext();
+		return *context;
+	}
+
+	bool isDefault() const { return this == &getDefault(); }
+
+#ifdef SIMUCORE_MULTI_INSTANCE
+	// Makes a context the thread's active one until the end of the scope
+	class Scope
+	{
+	public:
+		explicit Scope(SimuCoreContext &context) : previous_(current_), previous_serial_(current_serial_)
+		{
+			current_ = &context;
+			current_serial_ = context.serial_;
+		}
+		~Scope()
+		{
+			current_ = previous_;
+			current_serial_ = previous_serial_;
+		}
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	private:
+		SimuCoreContext *previous_;
+		uint64_t previous_serial_;
+	};
+
+	// The active context's instance of T. What getInstance() uses, so
+	// it is on every hot path: each thread caches the last instance per
+	// type, and the fast path is a few thread-local loads.
+	template <typename T>
+	static T &active()
+	{
+		const ActiveCache<T> &cache = active_cache_<T>;
+		if (cache.serial == current_serial_)
+			return *cache.instance;
+		return refresh<T>();
+	}
+#else
+	// Only the default context exists, so its singletons are plain
+	// function-local statics rather than entries in its table
+	class Scope
+	{
+	public:
+		explicit Scope(SimuCoreContext &) {}
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+	};
+
+	template <typename T>
+	static T &active()
+	{
+		static T instance;
+		return instance;
+	}
+#endif
+
+	// This context's instance of T, default-constructed on first use.
+	// Lock-free once it exists, so any thread may call it.
+	template <typename T>
+	T &get()
+	{
+		std::size_t slot = slotOf<T>();
+		void *instance = slots_[slot].load(std::memory_order_acquire);
+		if (!instance)
+			instance = create<T>(slot);
+		return *static_cast<T *>(instance);
+	}
+
+private:
+	// Enough for the fixed singletons plus a table and pool per value type
+#ifdef SIMUCORE_MAX_CONTEXT_SLOTS
+	static constexpr std::size_t maxSlots = SIMUCORE_MAX_CONTEXT_SLOTS;
+#else
+	static constexpr std::size_t maxSlots = 256;
+#endif
+
+	// Owns one instance; the singletons' constructors are private to
+	// everyone but SimuCoreContext, so create() does the new
+	struct Holder
+	{
+		virtual ~Holder() = default;
+	};
+
+	template <typename T>
+	struct Owner : Holder
+	{
+		explicit Owner(T *instance) : instance(instance) {}
+		~Owner() override { delete instance; }
+		T *instance;
+	};
+
+#ifdef SIMUCORE_MULTI_INSTANCE
+	template <typename T>
+	struct ActiveCache
+	{
+		T *instance = nullptr;
+		uint64_t serial = UINT64_MAX;
+	};
+
+	// Kept out of active() so that the fast path stays small enough to inline
+	template <typename T>
+	static T &refresh()
+	{
+		ActiveCache<T> &cache = active_cache_<T>;
+		cache.instance = &current().get<T>();
+		cache.serial = current_serial_;
+		return *cache.instance;
+	}
+#endif
+
+	// Serials are never reused, so a cache cannot mistake a new context
+	// for a destroyed one at the same address. 0 is the default context
+	// while no Scope is active.
+	static uint64_t nextSerial()
+	{
+		static std::atomic<uint64_t> next{1};
+		return next++;
+	}
+
+	static std::size_t nextSlot()
+	{
+		static std::atomic<std::size_t> next{0};
+		std::size_t slot = next++;
+		// A fixed array keeps get() safe next to creation on another thread
+		if (slot >= maxSlots)
+		{
+			// Straight to the platform: log() reads Config, which may be
+			// the type asking for this slot
+			SimuCoreLogger::log_("ERROR: No SimuCoreContext slot left for another singleton type, all " +
+								 std::to_string(maxSlots) + " are taken. Define SIMUCORE_MAX_CONTEXT_SLOTS larger.");
+			std::abort();
+		}
+		return slot;
+	}
+
+	template <typename T>
+	static std::size_t slotOf()
+	{
+		static const std::size_t slot = nextSlot();
+		return slot;
+	}
+
+	template <typename T>
+	void *create(std::size_t slot)
+	{
+		std::lock_guard<std::recursive_mutex> lock(create_mutex_);
+		void *instance = slots_[slot].load(std::memory_order_relaxed);
+		if (instance)
+			return instance;
+		T *created = new T();
+		created_.push_back(std::make_unique<Owner<T>>(created));
+		slots_[slot].store(created, std::memory_order_release);
+		return created;
+	}
+
+	std::array<std::atomic<void *>, maxSlots> slots_{};
+	// In creation order, so destruction runs in reverse
+	std::vector<std::unique_ptr<Holder>> created_;
+	// Recursive: creating Config also creates the ComponentTable and registry
+	std::recursive_mutex create_mutex_;
+	uint64_t serial_;
+
+#ifdef SIMUCORE_MULTI_INSTANCE
+	static inline thread_local SimuCoreContext *current_ = nullptr;
+	static inline thread_local uint64_t current_serial_ = 0;
+	template <typename T>
+	static inline thread_local ActiveCache<T> active_cache_{};
+#endif
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <SimuCore/SimuCoreApplication.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------
+// Runs several SimuCoreApplications in one process, e.g. the
+// scenarios of a batch regression run. Each instance gets its own
+// SimuCoreContext, so registries, configs and tick state are never
+// shared, and step() advances all of them on a fixed pool of worker
+// threads. An instance is only ever stepped by one worker at a time.
+// Native builds with SIMUCORE_MULTI_INSTANCE only.
+// ------------------------------------------------------------
+#ifndef SIMUCORE_MULTI_INSTANCE
+#error "SimuCoreHost needs per-instance contexts: build with -DSIMUCORE_MULTI_INSTANCE"
+#endif
+
+class SimuCoreHost
+{
+public:
+	explicit SimuCoreHost(unsigned threads = std::thread::hardware_concurrency());
+	~SimuCoreHost();
+
+	SimuCoreHost(const SimuCoreHost &) = delete;
+	SimuCoreHost &operator=(const SimuCoreHost &) = delete;
+
+	// Builds App(args...) in a fresh context and runs initApp(). The
+	// webserver is off: hosted instances share the process, not a port.
+	// Not to be called while step() runs.
+	template <typename App, typename... Args>
+	App &add(Args &&...args)
+	{
+		Instance instance;
+		instance.context = std::make_unique<SimuCoreContext>();
+		App *app;
+		{
+			SimuCoreContext::Scope scope(*instance.context);
+			SimuCore::getConfig().enable_webserver.setValue(false);
+			app = new App(std::forward<Args>(args)...);
+		}
+		instance.app.reset(app);
+		app->initApp();
+		std::unique_lock<std::mutex> lock(mutex_);
+		waitForIdleWorkers(lock);
+		instances_.push_back(std::move(instance));
+		return *app;
+	}
+
+	// Advances every instance by ticks ticks and returns once all are done
+	void step(uint64_t ticks = 1);
+
+	std::size_t size() const { return instances_.size(); }
+	SimuCoreApplication &get(std::size_t index) { return *instances_[index].app; }
+
+private:
+	struct Instance
+	{
+		// Declared first so it outlives the application
+		std::unique_ptr<SimuCoreContext> context;
+		std::unique_ptr<SimuCoreApplication> app;
+	};
+
+	void work();
+	// Until no worker is between taking an instance and finishing it
+	void waitForIdleWorkers(std::unique_lock<std::mutex> &lock);
+
+	std::vector<Instance> instances_;
+	std::vector<std::thread> workers_;
+
+	// Guards everything below, and instances_ against add()
+	std::mutex mutex_;
+	std::condition_variable work_ready_;
+	std::condition_variable work_done_;
+	std::condition_variable workers_idle_;
+	uint64_t generation_ = 0;
+	std::size_t pending_ = 0;
+	std::size_t active_workers_ = 0;
+	bool stopping_ = false;
+	uint64_t ticks_ = 0;
+	std::size_t count_ = 0;
+	std::size_t next_ = 0;
+};
@@ -7,5 +7,6 @@ public:
 	static void log(const std::string &message);
 
 private:
+	friend class SimuCoreContext;
 	static void log_(const std::string &message);
 };
\ No newline at end of file
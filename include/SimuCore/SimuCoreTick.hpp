@@ -5,7 +5,7 @@
 class SimuCoreTick
 {
 public:
-    SimuCoreTick() : _sleep_in_ms(1000u / SimuCore::config.sample_frequency.getValue())
+    SimuCoreTick() : _sleep_in_ms(1000u / SimuCore::getConfig().sample_frequency.getValue())
     {
     }
     virtual ~SimuCoreTick() = default;
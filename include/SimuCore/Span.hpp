@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// ------------------------------------------------------------
+// Non-owning view of a contiguous range, like C++20 std::span.
+// Lets the registry and the component tree hand out their lists
+// without copying them. Only valid as long as the viewed vector
+// is not resized, i.e. until the next component or signal is added.
+// ------------------------------------------------------------
+template <typename T>
+class Span
+{
+public:
+	constexpr Span() = default;
+	constexpr Span(T *data, std::size_t size) : data_(data), size_(size) {}
+	template <typename U>
+	Span(const std::vector<U> &vector) : data_(vector.data()), size_(vector.size()) {}
+	template <typename U>
+	Span(std::vector<U> &vector) : data_(vector.data()), size_(vector.size()) {}
+
+	constexpr T *begin() const { return data_; }
+	constexpr T *end() const { return data_ + size_; }
+	constexpr T *data() const { return data_; }
+	constexpr std::size_t size() const { return size_; }
+	constexpr bool empty() const { return size_ == 0; }
+	constexpr T &operator[](std::size_t index) const { return data_[index]; }
+
+private:
+	T *data_ = nullptr;
+	std::size_t size_ = 0;
+};
@@ -8,7 +8,7 @@ from simucore_pytest.core.schemas import Config, generate_simcore_schema
 type_map = {
     'integer': 'int',
     'boolean': 'bool',
-    'string': 'std::string',
+    'string': 'FixedString<{max_length}>',
     'number': 'double'
 }
 
@@ -30,11 +30,17 @@ def generate_config_class(env = None):
     parameters = []
     initializer_list = ['Component(parent, name)']
     for parameter_name, detail in properties.items():
-        parameter_value = str(simucore_base_config[parameter_name]).lower()
+        parameter_value = str(simucore_base_config.get(parameter_name, detail.get("default"))).lower()
         parameter_json_type = detail["type"]
+        max_length = detail.get("maxLength", 64)
         if parameter_json_type == 'string':
+            # FixedString would silently cut it; the schema only checks maxLength where one is given
+            if len(parameter_value.encode()) > max_length:
+                raise RuntimeError(f"Config parameter {parameter_name}: \"{parameter_value}\" is longer than {max_length} bytes. "
+                                   "Shorten it or give the parameter a larger maxLength.")
             parameter_value = f"\"{parameter_value}\""
-        parameters.append(f'Parameter<{type_map[parameter_json_type]}> {parameter_name};')
+        parameter_type = type_map[parameter_json_type].format(max_length=max_length)
+        parameters.append(f'Parameter<{parameter_type}> {parameter_name};')
         initializer_list.append(f'{parameter_name}(this, \"{parameter_name}\", {parameter_value})')
     cpp_template = """
 #pragma once
@@ -48,10 +54,18 @@ public:
     {class_name}({constructor_args})
         : {initializer_list} {{
     }}
+    {class_name}() : {class_name}(nullptr, "{class_name}") {{}}
 
     {member_functions}
 }};
 inline Config config(nullptr, "Config");
+// The active SimuCoreContext's config: config itself in the default
+// context, an instance of its own in any other
+inline Config &getConfig()
+{{
+    SimuCoreContext &context = SimuCoreContext::current();
+    return context.isDefault() ? config : context.get<Config>();
+}}
 }}
 """
     custom_class_values = {
@@ -37,7 +37,7 @@ class CppFunction:
 
 type_map = {
     "string": "std::string",
-    "integer": "unsigned int",
+    "integer": "std::uint64_t",
     "number": "double",
     "boolean": "bool"
 }
@@ -300,7 +300,7 @@ def generate_header(schema_filename, header_file_filename):
 
     os.makedirs(os.path.dirname(header_file), exist_ok=True)
     with open(header_file, "w") as f:
-        f.write("#pragma once\n\n#include <string>\n#include <vector>\n#include <variant>\n#include <SimuCore/json.hpp>\n\nnamespace SimuCore { \n\n")
+        f.write("#pragma once\n\n#include <cstdint>\n#include <string>\n#include <vector>\n#include <variant>\n#include <SimuCore/json.hpp>\n\nnamespace SimuCore { \n\n")
         f.write("\n\n".join(generated_structs))
         f.write("\n\n}")
 
@@ -340,7 +340,7 @@ def generate_cpp_and_header_files(env = None):
     header_file = include_dir.joinpath("Communication.hpp")
     os.makedirs(os.path.dirname(header_file), exist_ok=True)
     with open(header_file, "w") as f:
-        f.write("#pragma once\n\n#include <string>\n#include <vector>\n#include <variant>\n#include <SimuCore/json.hpp>\n\nnamespace SimuCore { \n\n")
+        f.write("#pragma once\n\n#include <cstdint>\n#include <string>\n#include <vector>\n#include <variant>\n#include <SimuCore/json.hpp>\n\nnamespace SimuCore { \n\n")
         f.write("\n\n".join(generated_structs))
         f.write("\n\n}")
 
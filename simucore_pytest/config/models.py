@@ -4,3 +4,4 @@ from pydantic import BaseModel, DirectoryPath
 
 class SimucoreTestConfig(BaseModel):
     platform_io_project_path: DirectoryPath
+    platformio_environment: str = "native"
@@ -10,25 +10,33 @@ class Parameter(BaseModel):
     name: str
     typeName: str
     value: str
+    # value holds only the first 255 bytes of a longer std::string
+    truncated: bool = False
+    Parameters: list[Parameter] | None = None
 
 class Output(BaseModel):
     id: int
     name: str
     typeName: str
     value: str
+    truncated: bool = False
     connectedInputs: list[ConnectedInput] | None = []
+    # Fields of a bus signal
+    Outputs: list[Output] | None = None
 
 class Input(BaseModel):
     id: int
     name: str
     typeName: str
     value: str
+    truncated: bool = False
+    Inputs: list[Input] | None = None
 
 class PhysicalInput(Input):
-    pass
+    PhysicalInputs: list[PhysicalInput] | None = None
 
 class PhysicalOutput(Output):
-    pass
+    PhysicalOutputs: list[PhysicalOutput] | None = None
 
 class Component(BaseModel):
     id: int
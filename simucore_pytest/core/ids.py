@@ -0,0 +1,22 @@
+FNV1A_OFFSET_BASIS = 0xCBF29CE484222325
+FNV1A_PRIME = 0x100000001B3
+_MASK = 0xFFFFFFFFFFFFFFFF
+
+
+def _fnv1a_append(hash_value: int, data: str) -> int:
+    for byte in data.encode():
+        hash_value ^= byte
+        hash_value = (hash_value * FNV1A_PRIME) & _MASK
+    return hash_value
+
+
+def component_id(*path: str) -> int:
+    """Same ID the C++ side assigns to the component at the given path (see Component.hpp)."""
+    component = 0
+    for name in path:
+        if component == 0:
+            hash_value = _fnv1a_append(FNV1A_OFFSET_BASIS, name)
+        else:
+            hash_value = _fnv1a_append(_fnv1a_append(component, "->"), name)
+        component = hash_value if hash_value != 0 else 1
+    return component
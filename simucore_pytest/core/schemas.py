@@ -13,7 +13,13 @@ COMMANDS = Literal[
     "STOP_SIMULATION",
     "TICK",
     "INFO",
-    "APPLICATION_TREE"
+    "APPLICATION_TREE",
+    "UPDATE_ELEMENTS",
+    "GET_HISTORY",
+    "GET_CHANGES",
+    "FORCE",
+    "RELEASE",
+    "RESOLVE"
 ]
 ResponseStatus = Literal["SUCCESS", "FAILURE", "WARNING"]
 
@@ -52,6 +58,13 @@ class UpdatePysicalInputsProtocol(BaseModel):
     parameters: list[UpdateInput]
 
 
+class UpdateElementsProtocol(BaseModel):
+    command: COMMANDS = "UPDATE_ELEMENTS"
+    id: int
+    offset: int = 0
+    values: list[str]
+
+
 class TickSystem(BaseModel):
     command: COMMANDS = "TICK"
     number_of_ticks: int
@@ -76,6 +89,76 @@ class Response(BaseModel):
     message: str
 
 
+class GetHistoryProtocol(BaseModel):
+    command: COMMANDS = "GET_HISTORY"
+    ids: list[int]
+
+
+class HistorySamples(BaseModel):
+    id: int
+    ticks: list[int]
+    values: list[str]
+
+
+class HistoryProtocol(BaseModel):
+    response: Response
+    signals: list[HistorySamples]
+
+
+class GetChangesProtocol(BaseModel):
+    command: COMMANDS = "GET_CHANGES"
+    since: int = 0
+
+
+class SignalChange(BaseModel):
+    id: int
+    value: str
+    tick: int
+    # value holds only the first 255 bytes of a longer std::string
+    truncated: bool = False
+
+
+class ChangesProtocol(BaseModel):
+    response: Response
+    tick: int
+    signals: list[SignalChange]
+
+
+class ForceSignal(BaseModel):
+    id: int
+    value: str
+    # Released automatically after this many ticks; 0 keeps it forced until RELEASE
+    ticks: int = 0
+
+
+class ForceProtocol(BaseModel):
+    command: COMMANDS = "FORCE"
+    signals: list[ForceSignal]
+
+
+class ReleaseProtocol(BaseModel):
+    command: COMMANDS = "RELEASE"
+    ids: list[int] = []
+    release_all: bool = False
+
+
+class ResolveProtocol(BaseModel):
+    command: COMMANDS = "RESOLVE"
+    # Full paths such as "App->Motor3->Speed"; segments may use *, ? and **
+    patterns: list[str]
+
+
+class ResolvedComponent(BaseModel):
+    path: str
+    id: int
+    type: str
+
+
+class ResolvedProtocol(BaseModel):
+    response: Response
+    components: list[ResolvedComponent]
+
+
 class ApplicationInfoProtocol(BaseModel):
     response: Response
     up_time_in_milli_seconds: int
@@ -86,6 +169,7 @@ class Config(BaseModel):
     sample_frequency: float = 100
     log_enabled: bool = False
     enable_webserver: bool = True
+    double_buffered_signals: bool = False
     blah: str
 
 
@@ -117,7 +201,16 @@ def generate_simucore_schemas(env):
         generate_simcore_schema(env, TickSystem),
         generate_simcore_schema(env, UpdatePysicalInputsProtocol),
         generate_simcore_schema(env, UpdataParametersProtocol),
+        generate_simcore_schema(env, UpdateElementsProtocol),
         generate_simcore_schema(env, ApplicationInfoProtocol),
+        generate_simcore_schema(env, GetHistoryProtocol),
+        generate_simcore_schema(env, HistoryProtocol),
+        generate_simcore_schema(env, GetChangesProtocol),
+        generate_simcore_schema(env, ChangesProtocol),
+        generate_simcore_schema(env, ForceProtocol),
+        generate_simcore_schema(env, ReleaseProtocol),
+        generate_simcore_schema(env, ResolveProtocol),
+        generate_simcore_schema(env, ResolvedProtocol),
         generate_simcore_schema(env, SimulationModelConfig),
     ]
     return all_schemas
@@ -10,9 +10,19 @@ from simucore_pytest.core.schemas import (
     ApplicationInfo,
     ApplicationInfoProtocol,
     ApplicationTreeData,
+    ChangesProtocol,
+    ForceProtocol,
+    ForceSignal,
+    GetChangesProtocol,
+    GetHistoryProtocol,
+    HistoryProtocol,
+    ReleaseProtocol,
+    ResolvedProtocol,
+    ResolveProtocol,
     Response,
     StartSimulation,
     TickSystem,
+    UpdateElementsProtocol,
     UpdateInput,
     UpdatePysicalInputsProtocol,
 )
@@ -25,6 +35,10 @@ class SimuCoreSystem:
         self._ws: ClientConnection | None = None
         self.application_tree: ApplicationTree
 
+    @property
+    def uri(self) -> str:
+        return self._uri
+
     @retry(
         stop=stop_after_attempt(5),
         wait=wait_fixed(2),
@@ -61,12 +75,45 @@ class SimuCoreSystem:
         )
         ws.recv()
 
+    def update_elements(self, id: int, values: list[str], offset: int = 0) -> Response:
+        ws = self._require_ws()
+        ws.send(UpdateElementsProtocol(id=id, offset=offset, values=values).model_dump_json())
+        return _response_list_adapter.validate_json(ws.recv())
+
+    def force(self, values: dict[int, str], ticks: int = 0) -> Response:
+        """Pin signals (internal ones too) to values until released, or for `ticks` ticks."""
+        ws = self._require_ws()
+        signals = [ForceSignal(id=id, value=value, ticks=ticks) for id, value in values.items()]
+        ws.send(ForceProtocol(signals=signals).model_dump_json())
+        return _response_list_adapter.validate_json(ws.recv())
+
+    def release(self, ids: list[int] | None = None) -> Response:
+        """Release the given forced signals, or every forced signal if ids is None."""
+        ws = self._require_ws()
+        ws.send(ReleaseProtocol(ids=ids or [], release_all=ids is None).model_dump_json())
+        return _response_list_adapter.validate_json(ws.recv())
+
     def get_application_info(self) -> ApplicationInfoProtocol:
         ws = self._require_ws()
         ws.send(ApplicationInfo().model_dump_json())
         json_data = json.loads(ws.recv())[0]
         return ApplicationInfoProtocol(**json_data)
 
+    def get_history(self, ids: list[int]) -> HistoryProtocol:
+        ws = self._require_ws()
+        ws.send(GetHistoryProtocol(ids=ids).model_dump_json())
+        return HistoryProtocol.model_validate_json(ws.recv())
+
+    def get_changes(self, since: int = 0) -> ChangesProtocol:
+        ws = self._require_ws()
+        ws.send(GetChangesProtocol(since=since).model_dump_json())
+        return ChangesProtocol.model_validate_json(ws.recv())
+
+    def resolve(self, patterns: list[str]) -> ResolvedProtocol:
+        ws = self._require_ws()
+        ws.send(ResolveProtocol(patterns=patterns).model_dump_json())
+        return ResolvedProtocol.model_validate_json(ws.recv())
+
     def get_application_tree(self) -> ApplicationTree:
         ws = self._require_ws()
         ws.send(ApplicationTreeData().model_dump_json())
@@ -1,5 +1,6 @@
 from collections.abc import Generator
 import json
+import os
 from pathlib import Path
 import subprocess
 
@@ -26,17 +27,21 @@ def pytest_configure(config: SimucorePytestConfig) -> None:
 
 def pytest_sessionstart(session: SimucorePytestSession) -> None:
     platformio_project_path = session.config.simucore_test_config.platform_io_project_path.resolve()
-    run_cli(["-d", platformio_project_path, "-e", "native", "-t", "fullclean", "-s"], standalone_mode=False)
-    run_cli(["-d", platformio_project_path, "-e", "native"], standalone_mode=False)
+    environment = session.config.simucore_test_config.platformio_environment
+    run_cli(["-d", platformio_project_path, "-e", environment, "-t", "fullclean", "-s"], standalone_mode=False)
+    run_cli(["-d", platformio_project_path, "-e", environment], standalone_mode=False)
 
 
 @pytest.fixture(scope="session")
 def simulation_instance_session(request: SimucorePytestSession) -> Generator[SimuCoreSystem]:
     platformio_project_path = request.config.simucore_test_config.platform_io_project_path.resolve()
-    meta = load_build_metadata(platformio_project_path, ["native"])
+    environment = request.config.simucore_test_config.platformio_environment
+    meta = load_build_metadata(platformio_project_path, [environment])
     assert meta
-    prog_path = meta["native"]["prog_path"]
-    process = subprocess.Popen([prog_path])
+    prog_path = meta[environment]["prog_path"]
+    # Sanitizer builds stop at the first report, so the test that caused it fails
+    env = {"TSAN_OPTIONS": "halt_on_error=1", **os.environ}
+    process = subprocess.Popen([prog_path], env=env)
     try:
         simucore_system = SimuCoreSystem()
         yield simucore_system
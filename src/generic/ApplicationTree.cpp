@@ -5,7 +5,9 @@
 
 const nlohmann::json ApplicationTree::getApplicationTreeAsJson()
 {
-    auto buildJsonTree = [](Component *component, auto &self) -> nlohmann::json
+    // Served to network threads, so read values from the tick-consistent snapshot
+    const SnapshotView snapshot = SignalRegistry::getInstance().readSnapshot();
+    auto buildJsonTree = [&snapshot](Component *component, auto &self) -> nlohmann::json
     {
         nlohmann::json componentJson;
         componentJson["name"] = component->getName();
@@ -19,7 +21,9 @@ const nlohmann::json ApplicationTree::getApplicationTreeAsJson()
         {
             const auto signal = SignalRegistry::getInstance().find(component->getId());
 
-            componentJson["value"] = signal->getValueAsString();
+            componentJson["value"] = signal->getValueAsString(snapshot);
+            if (signal->isTruncated(snapshot))
+                componentJson["truncated"] = true;
             componentJson["typeName"] = signal->getTypeName();
             
             if (component->getComponentType() == ComponentType::INTERNAL_OUTPUT)
@@ -0,0 +1,150 @@
+#include <SimuCore/PathIndex.hpp>
+#include <algorithm>
+#include <unordered_set>
+
+namespace
+{
+constexpr std::string_view separator = "->";
+
+// Splits "A->B->C" into its segments; repeated "**" segments collapse into one
+std::vector<std::string_view> splitPath(std::string_view path)
+{
+    std::vector<std::string_view> segments;
+    std::size_t start = 0;
+    while (true)
+    {
+        std::size_t end = path.find(separator, start);
+        std::string_view segment = path.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        if (!(segment == "**" && !segments.empty() && segments.back() == "**"))
+            segments.push_back(segment);
+        if (end == std::string_view::npos)
+            return segments;
+        start = end + separator.size();
+    }
+}
+}
+
+void PathIndex::build(Component *root)
+{
+    // Readers may already be using the index, so it is built once
+    if (isBuilt() || !root)
+        return;
+    nodes_.clear();
+    nodes_.push_back({"", nullptr, 1, 1});
+    nodes_.push_back({root->getName(), root, 0, 0});
+    for (uint32_t i = 1; i < nodes_.size(); ++i)
+    {
+        auto first = static_cast<uint32_t>(nodes_.size());
+        for (auto *sub : nodes_[i].component->getSubComponents())
+            nodes_.push_back({sub->getName(), sub, 0, 0});
+        std::sort(nodes_.begin() + first, nodes_.end(), [](const Node &a, const Node &b)
+                  { return a.name < b.name; });
+        nodes_[i].first_child = first;
+        nodes_[i].child_count = static_cast<uint32_t>(nodes_.size()) - first;
+    }
+    built_.store(true, std::memory_order_release);
+}
+
+std::pair<uint32_t, uint32_t> PathIndex::childrenWithPrefix(const Node &node, std::string_view prefix, bool exact) const
+{
+    auto begin = nodes_.begin() + node.first_child;
+    auto end = begin + node.child_count;
+    auto first = std::lower_bound(begin, end, prefix, [](const Node &child, std::string_view name)
+                                  { return std::string_view(child.name) < name; });
+    auto last = std::partition_point(first, end, [&](const Node &child)
+                                     {
+        std::string_view name = child.name;
+        return exact ? name == prefix : name.substr(0, prefix.size()) == prefix; });
+    return {static_cast<uint32_t>(first - nodes_.begin()), static_cast<uint32_t>(last - nodes_.begin())};
+}
+
+Component *PathIndex::find(std::string_view path) const
+{
+    if (!isBuilt())
+        return nullptr;
+    uint32_t node = 0;
+    for (auto segment : splitPath(path))
+    {
+        auto range = childrenWithPrefix(nodes_[node], segment, true);
+        if (range.first == range.second)
+            return nullptr;
+        node = range.first;
+    }
+    return nodes_[node].component;
+}
+
+void PathIndex::match(std::string_view pattern, std::vector<Component *> &matches) const
+{
+    if (!isBuilt())
+        return;
+    auto segments = splitPath(pattern);
+    std::size_t first_match = matches.size();
+    matchFrom(0, segments, 0, matches);
+
+    // Two "**" segments can reach the same component along different splits
+    if (std::count(segments.begin(), segments.end(), "**") > 1)
+    {
+        std::unordered_set<Component *> seen;
+        auto last = std::remove_if(matches.begin() + first_match, matches.end(), [&](Component *component)
+                                   { return !seen.insert(component).second; });
+        matches.erase(last, matches.end());
+    }
+}
+
+void PathIndex::matchFrom(uint32_t node, const std::vector<std::string_view> &segments, std::size_t segment,
+                          std::vector<Component *> &matches) const
+{
+    if (segment == segments.size())
+    {
+        if (nodes_[node].component)
+            matches.push_back(nodes_[node].component);
+        return;
+    }
+    std::string_view pattern = segments[segment];
+    if (pattern == "**")
+    {
+        matchFrom(node, segments, segment + 1, matches);
+        for (uint32_t i = 0; i < nodes_[node].child_count; ++i)
+            matchFrom(nodes_[node].first_child + i, segments, segment, matches);
+        return;
+    }
+
+    std::size_t wildcard = pattern.find_first_of("*?");
+    bool exact = wildcard == std::string_view::npos;
+    auto range = childrenWithPrefix(nodes_[node], pattern.substr(0, wildcard), exact);
+    for (uint32_t child = range.first; child < range.second; ++child)
+    {
+        if (exact || globMatch(pattern, nodes_[child].name))
+            matchFrom(child, segments, segment + 1, matches);
+    }
+}
+
+bool PathIndex::globMatch(std::string_view pattern, std::string_view text)
+{
+    std::size_t p = 0, t = 0;
+    std::size_t star = std::string_view::npos, star_text = 0;
+    while (t < text.size())
+    {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+        {
+            ++p;
+            ++t;
+        }
+        else if (p < pattern.size() && pattern[p] == '*')
+        {
+            star = p++;
+            star_text = t;
+        }
+        else if (star != std::string_view::npos)
+        {
+            // Let the last '*' swallow one more character and retry
+            p = star + 1;
+            t = ++star_text;
+        }
+        else
+            return false;
+    }
+    while (p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
@@ -1,6 +1,7 @@
 #include <SimuCore/generated/Config.hpp>
 #include <SimuCore/SimuCoreApplication.hpp>
 #include <unordered_set>
+#include <mutex>
 #include <string>
 
 void to_json(nlohmann::json &j, SignalBase *signal)
@@ -14,10 +15,11 @@ void to_json(nlohmann::json &j, SignalBase *signal)
 
 SimuCoreApplication::SimuCoreApplication(const std::string &applicationName)
     : Component(nullptr, applicationName),
+      context_(SimuCoreContext::current()),
       hal(SimuCoreHAL::create()),
       simu_core_tick(SimuCoreTick::create()),
       _applicationTree(this),
-      websocket_server_(SimuCore::config.enable_webserver.getValue()
+      websocket_server_(SimuCore::getConfig().enable_webserver.getValue()
                             ? SimuCoreWebsocketServer::create_websocket_server()
                             : std::make_unique<NoImplementationWebsocketServer>())
 {
@@ -30,14 +32,18 @@ SimuCoreApplication::SimuCoreApplication(const std::string &applicationName)
 
 void SimuCoreApplication::on_connection(int clientId, bool connected)
 {
+    SimuCoreContext::Scope scope(context_);
     if (connected)
     {
-        websocket_server_->send_message_to_client(clientId, _applicationTreeJson.dump());
+        // Not waiting for requestDerivedValues(): telemetry to the new
+        // client would overtake the tree
+        websocket_server_->send_message_to_client(clientId, _applicationTree.getApplicationTreeAsJson().dump());
     }
 }
 
 void SimuCoreApplication::on_message(int clientId, const std::string &message)
 {
+    SimuCoreContext::Scope scope(context_);
     nlohmann::json jsonMsg = nlohmann::json::parse(message);
     if (!jsonMsg.contains("command"))
     {
@@ -53,7 +59,8 @@ void SimuCoreApplication::on_message(int clientId, const std::string &message)
     SimuCore::CommandEnum command = jsonMsg["command"];
     if (command == SimuCore::CommandEnum::SUBSCRIBE)
     {
-        std::unordered_set<int> idsSubscribedTo;
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        std::unordered_set<ComponentId> idsSubscribedTo;
         for (auto &item : this->subscriptions)
         {
             idsSubscribedTo.insert(item.id);
@@ -69,6 +76,7 @@ void SimuCoreApplication::on_message(int clientId, const std::string &message)
             else
             {
                 subscriptions.push_back(signal);
+                refresh_all_subscriptions_ = true;
                 successResponse.message += "subscribed to: " + std::to_string(signal.id) + " ";
             }
         }
@@ -76,10 +84,17 @@ void SimuCoreApplication::on_message(int clientId, const std::string &message)
     }
     else if (command == SimuCore::CommandEnum::START_SIMULATION)
     {
+        if (!has_been_initialized)
+        {
+            SimuCore::Response errorResponse{
+                .status = SimuCore::StatusEnum::FAILURE,
+                .message = "Application failed to initialise!"};
+            websocket_server_->send_message_to_client(clientId, nlohmann::json(errorResponse).dump());
+            return;
+        }
+        // The reset runs on the tick thread, which also sends the response
         simulation_system.is_simulating = true;
-        this->reset_system();
-        SimuCoreLogger::log("Starting simulation");
-        websocket_server_->send_message_to_client(clientId, nlohmann::json(successResponse).dump());
+        simulation_system.reset_requested_by = clientId;
     }
     else if (command == SimuCore::CommandEnum::STOP_SIMULATION)
     {
@@ -93,42 +108,285 @@ void SimuCoreApplication::on_message(int clientId, const std::string &message)
     }
     else if (command == SimuCore::CommandEnum::UPDATE_PHYSICAL_INPUT) {
         SimuCore::UpdatePysicalInputsProtocol update_inputs = jsonMsg;
-        for (const auto &signal : update_inputs.parameters) {
-            SignalRegistry::getInstance().changeSignalValue(signal.id, signal.value);
-            auto new_signal = SignalRegistry::getInstance().find(signal.id);
+        InboundWrites inbound{clientId, {}};
+        for (const auto &signal : update_inputs.parameters)
+            inbound.writes.push_back({signal.id, SignalWriteKind::Value, 0, {signal.value}, 0});
+        queueWrites(std::move(inbound));
+    }
+    else if (command == SimuCore::CommandEnum::UPDATE_ELEMENTS) {
+        SimuCore::UpdateElementsProtocol update_elements = jsonMsg;
+        queueWrites({clientId, {{update_elements.id, SignalWriteKind::Elements, update_elements.offset, std::move(update_elements.values), 0}}});
+    }
+    else if (command == SimuCore::CommandEnum::FORCE) {
+        SimuCore::ForceProtocol force = jsonMsg;
+        InboundWrites inbound{clientId, {}};
+        for (const auto &signal : force.signals)
+            inbound.writes.push_back({signal.id, SignalWriteKind::Force, 0, {signal.value}, signal.ticks});
+        queueWrites(std::move(inbound));
+    }
+    else if (command == SimuCore::CommandEnum::RELEASE) {
+        SimuCore::ReleaseProtocol release = jsonMsg;
+        InboundWrites inbound{clientId, {}};
+        if (release.release_all)
+            inbound.writes.push_back({0, SignalWriteKind::ReleaseAll, 0, {}, 0});
+        for (auto id : release.ids)
+            inbound.writes.push_back({id, SignalWriteKind::Release, 0, {}, 0});
+        queueWrites(std::move(inbound));
+    }
+    else if (command == SimuCore::CommandEnum::GET_HISTORY) {
+        SimuCore::GetHistoryProtocol get_history = jsonMsg;
+        if (!history_requests_.push({clientId, std::move(get_history.ids)}))
+        {
+            SimuCore::Response errorResponse{
+                .status = SimuCore::StatusEnum::FAILURE,
+                .message = "History request queue is full!"};
+            websocket_server_->send_message_to_client(clientId, nlohmann::json(errorResponse).dump());
         }
-        websocket_server_->send_message_to_client(clientId, nlohmann::json(successResponse).dump());
+    }
+    else if (command == SimuCore::CommandEnum::GET_CHANGES) {
+        SimuCore::GetChangesProtocol get_changes = jsonMsg;
+        SimuCore::ChangesProtocol changes;
+        changes.response = successResponse;
+        std::vector<SignalRegistry::ChangedSignal> changed;
+        SignalRegistry::getInstance().requestDerivedValues();
+        // Pass this tick as the next "since" to pick up where this reply left off
+        changes.tick = SignalRegistry::getInstance().readChangesSince(get_changes.since, changed);
+        for (const auto &change : changed)
+            changes.signals.push_back({change.signal->getId(), change.signal->getValueAsString(change.value), change.tick,
+                                       change.signal->isTruncated(change.value)});
+        websocket_server_->send_message_to_client(clientId, nlohmann::json(changes).dump());
+    }
+    else if (command == SimuCore::CommandEnum::RESOLVE) {
+        SimuCore::ResolveProtocol resolve = jsonMsg;
+        SimuCore::ResolvedProtocol resolved;
+        resolved.response = successResponse;
+        std::vector<Component *> matches;
+        for (const auto &pattern : resolve.patterns)
+        {
+            matches.clear();
+            _pathIndex.match(pattern, matches);
+            if (matches.empty())
+            {
+                resolved.response.status = SimuCore::StatusEnum::WARNING;
+                resolved.response.message += "Nothing matches " + pattern + "! ";
+            }
+            for (auto *component : matches)
+                resolved.components.push_back({component->getFullName(), component->getId(), component->getComponentTypeName()});
+        }
+        websocket_server_->send_message_to_client(clientId, nlohmann::json(resolved).dump());
     }
     else if (command == SimuCore::CommandEnum::INFO) {
         SimuCore::ApplicationInfoProtocol applicationInfo;
         applicationInfo.response = SimuCore::Response{.status = SimuCore::StatusEnum::SUCCESS, .message = "Info"};
-        applicationInfo.subscribed_signals = subscriptions;
+        {
+            std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+            applicationInfo.subscribed_signals = subscriptions;
+        }
         applicationInfo.up_time_in_milli_seconds = _up_time_in_milli_seconds;
         websocket_server_->send_message_to_client(clientId, nlohmann::json{applicationInfo}.dump());
     }
     else if (command == SimuCore::CommandEnum::APPLICATION_TREE) {
+        SignalRegistry::getInstance().requestDerivedValues();
         websocket_server_->send_message_to_client(clientId, _applicationTree.getApplicationTreeAsJson().dump());
     }
 }
 
-void SimuCoreApplication::initApp()
+bool SimuCoreApplication::initApp()
 {
-    _applicationTreeJson = _applicationTree.getApplicationTreeAsJson();
-    if (_initialApplicationTreeJson.is_null()) {
-        _initialApplicationTreeJson = _applicationTreeJson;
-    }
+    SimuCoreContext::Scope scope(context_);
     _up_time_in_milli_seconds = 0;
+    applyTickMode();
     bindSignals();
+    const PropagationPlan &plan = SignalRegistry::getInstance().compilePropagationPlan();
+    SimuCoreLogger::log("Propagation plan: " + std::to_string(plan.routeCount()) + " outputs, " +
+                        std::to_string(plan.destinationCount()) + " bound inputs");
+    if (!SignalRegistry::getInstance().freeze(this))
+    {
+        // Writes and lookups by ID would reach the wrong signal
+        SimuCoreLogger::log("ERROR: Component IDs are not unique, the application is not started");
+        return false;
+    }
+    _pathIndex.build(this);
+    if (SimuCore::getConfig().enable_webserver.getValue())
+        SignalRegistry::getInstance().enableSnapshots();
     initAll();
+    has_been_initialized = true;
+    return true;
+}
+
+void SimuCoreApplication::queueWrites(InboundWrites writes)
+{
+    int clientId = writes.client_id;
+    if (!inbound_writes_.push(std::move(writes)))
+    {
+        SimuCore::Response errorResponse{
+            .status = SimuCore::StatusEnum::FAILURE,
+            .message = "Inbound write queue is full!"};
+        websocket_server_->send_message_to_client(clientId, nlohmann::json(errorResponse).dump());
+    }
+}
+
+void SimuCoreApplication::applyInboundWrites()
+{
+    InboundWrites inbound;
+    while (inbound_writes_.pop(inbound))
+        inbound_batch_.push_back(std::move(inbound));
+    if (inbound_batch_.empty())
+        return;
+
+    // Last writer wins: a value or elements write is dropped when a later
+    // whole-value write to the same signal follows it. Only writes that
+    // pass their checks drop or are dropped, so an invalid write neither
+    // hides a valid one nor goes unreported. Force and release always
+    // run, and no write is dropped across them.
+    auto &registry = SignalRegistry::getInstance();
+    std::size_t count = 0;
+    for (const auto &message : inbound_batch_)
+        count += message.writes.size();
+    std::vector<bool> superseded(count, false);
+    std::unordered_set<ComponentId> overwritten;
+    std::size_t position = count;
+    for (auto message = inbound_batch_.rbegin(); message != inbound_batch_.rend(); ++message)
+        for (auto write = message->writes.rbegin(); write != message->writes.rend(); ++write)
+        {
+            --position;
+            switch (write->kind)
+            {
+            case SignalWriteKind::Value:
+                if (registry.checkSignalValue(write->id, write->values.front()).result == SetValueByStringResult::Success)
+                    superseded[position] = !overwritten.insert(write->id).second;
+                break;
+            case SignalWriteKind::Elements:
+                superseded[position] = overwritten.count(write->id) != 0 &&
+                                       registry.checkSignalElements(write->id, write->offset, write->values).result == SetValueByStringResult::Success;
+                break;
+            case SignalWriteKind::Force:
+            case SignalWriteKind::Release:
+                overwritten.erase(write->id);
+                break;
+            case SignalWriteKind::ReleaseAll:
+                overwritten.clear();
+                break;
+            }
+        }
+
+    std::vector<SimuCore::Response> responses(inbound_batch_.size(), SimuCore::Response{.status = SimuCore::StatusEnum::SUCCESS, .message = ""});
+    position = 0;
+    for (std::size_t i = 0; i < inbound_batch_.size(); ++i)
+        for (const auto &write : inbound_batch_[i].writes)
+        {
+            if (superseded[position++])
+                continue;
+            SetValueResponse result{SetValueByStringResult::Success, ""};
+            switch (write.kind)
+            {
+            case SignalWriteKind::Value:
+                result = registry.changeSignalValue(write.id, write.values.front());
+                break;
+            case SignalWriteKind::Elements:
+                result = registry.changeSignalElements(write.id, write.offset, write.values);
+                break;
+            case SignalWriteKind::Force:
+                result = registry.force(write.id, write.values.front(), write.ticks);
+                break;
+            case SignalWriteKind::Release:
+                // Releasing a signal that is not forced is a no-op
+                registry.release(write.id);
+                break;
+            case SignalWriteKind::ReleaseAll:
+                registry.releaseAll();
+                break;
+            }
+            if (result.result != SetValueByStringResult::Success)
+            {
+                responses[i].status = SimuCore::StatusEnum::FAILURE;
+                responses[i].message += (responses[i].message.empty() ? "" : " ") + result.message;
+            }
+        }
+
+    // Answer only once the new values can be read back
+    registry.publishSnapshot();
+    for (std::size_t i = 0; i < inbound_batch_.size(); ++i)
+        websocket_server_->send_message_to_client(inbound_batch_[i].client_id, nlohmann::json(responses[i]).dump());
+    inbound_batch_.clear();
+}
+
+void SimuCoreApplication::answerHistoryRequests()
+{
+    HistoryRequest request;
+    while (history_requests_.pop(request))
+    {
+        SimuCore::HistoryProtocol history;
+        history.response = SimuCore::Response{.status = SimuCore::StatusEnum::SUCCESS, .message = ""};
+        for (auto id : request.ids)
+        {
+            auto signal_history = SignalRegistry::getInstance().findHistory(id);
+            if (!signal_history)
+            {
+                history.response.status = SimuCore::StatusEnum::WARNING;
+                history.response.message += "Signal " + std::to_string(id) + " has no history! ";
+                continue;
+            }
+            SimuCore::HistorySamples samples;
+            samples.id = id;
+            signal_history->getSamples(samples.ticks, samples.values);
+            history.signals.push_back(std::move(samples));
+        }
+        websocket_server_->send_message_to_client(request.client_id, nlohmann::json(history).dump());
+    }
+}
+
+void SimuCoreApplication::applyTickMode()
+{
+    // A client may switch double buffering between ticks through the parameter
+    SignalRegistry::getInstance().setDoubleBuffered(SimuCore::getConfig().double_buffered_signals.getValue());
+}
+
+void SimuCoreApplication::step()
+{
+    if (!has_been_initialized)
+        return;
+    SimuCoreContext::Scope scope(context_);
+    applyInboundWrites();
+    answerHistoryRequests();
+    SignalRegistry::getInstance().serveDerivedRequests();
+    applyTickMode();
+    executeAll();
+    SignalRegistry::getInstance().endTick();
+    _up_time_in_milli_seconds += static_cast<int>(1000 / SimuCore::getConfig().sample_frequency.getValue());
 }
 
 void SimuCoreApplication::run()
 {
+    if (!has_been_initialized)
+    {
+        simu_core_tick->wait_for_next_tick();
+        return;
+    }
+    SimuCoreContext::Scope scope(context_);
+    applyInboundWrites();
+    answerHistoryRequests();
+    SignalRegistry::getInstance().serveDerivedRequests();
+
+    int reset_client = simulation_system.reset_requested_by.exchange(-1);
+    if (reset_client >= 0)
+    {
+        reset_system();
+        SimuCoreLogger::log("Starting simulation");
+        SimuCore::Response successResponse;
+        successResponse.status = SimuCore::StatusEnum::SUCCESS;
+        websocket_server_->send_message_to_client(reset_client, nlohmann::json(successResponse).dump());
+        return;
+    }
+
     if (simulation_system.is_simulating.load())
     {
-        while (simulation_system.ticks_remaining.load() == 0) { }
+        if (simulation_system.ticks_remaining.load() == 0)
+            return;
+        applyTickMode();
         executeAll();
-        _up_time_in_milli_seconds += 1000 / SimuCore::config.sample_frequency.getValue();
+        SignalRegistry::getInstance().endTick();
+        _up_time_in_milli_seconds += static_cast<int>(1000 / SimuCore::getConfig().sample_frequency.getValue());
         int prev = simulation_system.ticks_remaining.fetch_sub(1);
         if (prev == 1) {
             SimuCore::Response successResponse;
@@ -139,11 +397,15 @@ void SimuCoreApplication::run()
     }
     else
     {
+        applyTickMode();
         executeAll();
-        _up_time_in_milli_seconds += 1000 / SimuCore::config.sample_frequency.getValue();
+        // Let telemetry see this tick's double-buffered outputs
+        SignalRegistry::getInstance().commit();
+        _up_time_in_milli_seconds += static_cast<int>(1000 / SimuCore::getConfig().sample_frequency.getValue());
         
         if (!simulation_system.is_simulating.load()) // check again before sending to avoid race condition
             sendSignalValuesToWebsockets();
+        SignalRegistry::getInstance().endTick();
             
         simu_core_tick->wait_for_next_tick();
     }
@@ -151,9 +413,29 @@ void SimuCoreApplication::run()
 
 void SimuCoreApplication::sendSignalValuesToWebsockets()
 {
+    // Never wait for a client thread; if one is editing the list, skip
+    // this tick and refresh every subscription on the next one
+    std::unique_lock<std::mutex> lock(subscriptions_mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        refresh_all_subscriptions_ = true;
+        return;
+    }
+    for (auto &subscription : subscriptions)
+    {
+        auto signal = SignalRegistry::getInstance().find(subscription.id);
+        if (!signal)
+            continue;
+        signal->evaluate();
+        if (refresh_all_subscriptions_ || signal->valueHasChanged())
+            subscription.value = signal->getValueAsString();
+    }
+    refresh_all_subscriptions_ = false;
+
     SimuCore::ApplicationInfoProtocol applicationInfo;
     applicationInfo.response = SimuCore::Response{.status = SimuCore::StatusEnum::SUCCESS, .message = "Info"};
     applicationInfo.subscribed_signals = subscriptions;
+    lock.unlock();
     applicationInfo.up_time_in_milli_seconds = _up_time_in_milli_seconds;
 
     websocket_server_->send_message_to_connected_clients(nlohmann::json{applicationInfo}.dump());
@@ -169,8 +451,9 @@ void SimuCoreApplication::execute()
 }
 void SimuCoreApplication::reset_system()
 {
-    _applicationTreeJson = _initialApplicationTreeJson;
-    const auto signalRegistry = &SignalRegistry::getInstance();
-    signalRegistry->reset_signals();
-    this->initApp();
+    // Bindings, the propagation plan and the indexes outlive a reset; only
+    // signal state is restored and the components are initialised again
+    SignalRegistry::getInstance().reset_signals();
+    _up_time_in_milli_seconds = 0;
+    initAll();
 }
\ No newline at end of file
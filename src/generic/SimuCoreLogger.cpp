@@ -3,7 +3,7 @@
 
 void SimuCoreLogger::log(const std::string &message)
 {
-    if (SimuCore::config.log_enabled.getValue())
+    if (SimuCore::getConfig().log_enabled.getValue())
     {
         SimuCoreLogger::log_(message);
     }
@@ -0,0 +1,79 @@
+// Only built for multi-instance builds; see SimuCoreHost.hpp
+#ifdef SIMUCORE_MULTI_INSTANCE
+#include <SimuCore/SimuCoreHost.hpp>
+
+SimuCoreHost::SimuCoreHost(unsigned threads)
+{
+    // hardware_concurrency() may report 0
+    if (threads == 0)
+        threads = 1;
+    for (unsigned i = 0; i < threads; ++i)
+        workers_.emplace_back([this]
+                              { work(); });
+}
+
+SimuCoreHost::~SimuCoreHost()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto &worker : workers_)
+        worker.join();
+}
+
+void SimuCoreHost::step(uint64_t ticks)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (instances_.empty())
+        return;
+    pending_ = instances_.size();
+    ticks_ = ticks;
+    count_ = instances_.size();
+    next_ = 0;
+    ++generation_;
+    work_ready_.notify_all();
+    work_done_.wait(lock, [this]
+                    { return pending_ == 0; });
+}
+
+void SimuCoreHost::waitForIdleWorkers(std::unique_lock<std::mutex> &lock)
+{
+    workers_idle_.wait(lock, [this]
+                       { return active_workers_ == 0; });
+}
+
+void SimuCoreHost::work()
+{
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        work_ready_.wait(lock, [&]
+                         { return stopping_ || generation_ != generation; });
+        if (stopping_)
+            return;
+        generation = generation_;
+        ++active_workers_;
+        // Instances are handed out one at a time, so a slow one does not
+        // hold up the rest. The index is taken under the lock together
+        // with the generation check, so a worker still finishing the
+        // previous step can never claim one for the next.
+        while (generation_ == generation && next_ < count_)
+        {
+            SimuCoreApplication &app = *instances_[next_++].app;
+            uint64_t ticks = ticks_;
+            lock.unlock();
+            for (uint64_t tick = ticks; tick > 0; --tick)
+                app.step();
+            lock.lock();
+            if (--pending_ == 0)
+                work_done_.notify_one();
+        }
+        if (--active_workers_ == 0)
+            workers_idle_.notify_all();
+    }
+}
+
+#endif
@@ -4,6 +4,21 @@
 #include <SimuCore/Binding.hpp>
 #include <iostream>
 
+struct DriveBus
+{
+	double speed = 0;
+	double torque = 0;
+	int mode = 0;
+
+	template <typename F>
+	static void fields(F &&field)
+	{
+		field("speed", &DriveBus::speed);
+		field("torque", &DriveBus::torque);
+		field("mode", &DriveBus::mode);
+	}
+};
+
 class AnotherTestComponent : public Component
 {
 public:
@@ -12,11 +27,17 @@ public:
 	}
 	void execute()
 	{
+		echo.setValue(input.getValue());
 	}
 	void init()
 	{
 	}
 	InputSignal<int> input;
+	InputSignal<DriveBus> drive{this, "Drive"};
+	// Runs after its parent: passes the parent's output back up to it
+	OutputSignal<int> echo{this, "Echo"};
+	// Aliased to the parent's setting, so it reads it in place
+	InputSignal<int> setting{this, "Setting"};
 };
 
 class TestComponent : public Component
@@ -24,23 +45,56 @@ class TestComponent : public Component
 public:
 	TestComponent(Component *parent, std::string name) : Component(parent, name), testcomp(this, "TestComponent2"), output(this, "Someoutput")
 	{
+		output.enableHistory(1000);
+		doubled_output.enableHistory(1000);
+		testcomp.echo.enableHistory(1000);
+		echo_copy.enableHistory(1000);
+		written_output.enableHistory(1000);
+		pressure.setDeadband(0.5);
 	}
 	void execute()
 	{
-		static int i = 0;
+		written_output.setValue(i);
 		output.setValue(i++);
+		echo_copy.setValue(echo_input.getValue());
+		setting.setValue(physical_input_signal.getValue());
 		output_double.setValue(3.14);
+		drive.setValue({static_cast<double>(i), 2.0 * i, 1});
 	}
 	void init()
 	{
 	}
 
+private:
+	// Per instance, so that hosted instances do not share it
+	int i = 0;
+
 public:
 	AnotherTestComponent testcomp;
 	OutputSignal<int> output;
 	OutputSignal<double> output_double{this, "OutputDouble", 3.14};
 	OutputSignal<double> output_double2{this, "Din mor er en hest", 3.14};
 	PhysicalInput<int> physical_input_signal{this, "Physical input signal", 2};
+	PhysicalInput<std::array<double, 4>> temperature_strip{this, "Temperature strip"};
+	OutputSignal<DriveBus> drive{this, "Drive"};
+	PhysicalInput<Q15> gain{this, "Gain", Q15(0.5)};
+	PhysicalInput<FixedString<8>> label{this, "Label", "start"};
+	PhysicalInput<std::string> description{this, "Description", "short"};
+	PhysicalInput<double> pressure{this, "Pressure", 1.0};
+	DerivedSignal<double> doubled_output{this, "Doubled output", [this]
+										 { return 2.0 * output.getValue(); }, {&output}};
+	// Read by no input and no history: only computed when a client asks
+	DerivedSignal<int> tripled_output{this, "Tripled output", [this]
+									  {
+										  tripled_evaluations.setValue(tripled_evaluations.getValue() + 1);
+										  return 3 * output.getValue(); }, {&output}};
+	PhysicalOutput<int> tripled_evaluations{this, "Tripled evaluations"};
+	InputSignal<int> echo_input{this, "Echo input"};
+	OutputSignal<int> echo_copy{this, "Echo copy"};
+	// What output was set to, without double buffering
+	PhysicalOutput<int> written_output{this, "Written output"};
+	// Only changes when a client changes the physical input
+	OutputSignal<int> setting{this, "Setting"};
 };
 
 class Application : public SimuCoreApplication
@@ -59,6 +113,9 @@ public:
 	void bindSignals()
 	{
 		ComponentBinder::bind(testcomp.output, testcomp.testcomp.input);
+		ComponentBinder::bind(testcomp.drive, testcomp.testcomp.drive);
+		ComponentBinder::bind(testcomp.testcomp.echo, testcomp.echo_input);
+		ComponentBinder::bind(testcomp.setting, testcomp.testcomp.setting, BindingMode::Alias);
 	}
 
 public:
@@ -1,11 +1,15 @@
 #include <Application.hpp>
 #include <SimuCore/generated/Config.hpp>
+#include <clocale>
 #include <memory>
 #include <iostream>
 Application *application = new Application();
 
 void setup()
 {
+	// Take LC_NUMERIC etc. from the environment, so signal conversions
+	// can be checked to ignore it (see test_float_round_trip)
+	std::setlocale(LC_ALL, "");
 	application->initApp();
 }
 
@@ -0,0 +1,77 @@
+#include <Application.hpp>
+#include <SimuCore/SimuCoreHost.hpp>
+#include <SimuCore/json.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int numberOfInstances = 4;
+constexpr int numberOfWorkers = 2;
+constexpr uint64_t ticksPerStep = 25;
+constexpr int numberOfSteps = 2;
+// Added one per single-tick step afterwards, while the workers may
+// still be winding down the previous step
+constexpr int numberOfLateInstances = 8;
+
+// What the active context's registry holds
+nlohmann::json describeRegistry()
+{
+	auto &registry = SignalRegistry::getInstance();
+	return {{"registry", std::to_string(reinterpret_cast<std::uintptr_t>(&registry))},
+			{"tick", registry.getTick()},
+			{"signals", registry.getAllSignals().size()}};
+}
+}
+
+void setup()
+{
+	SimuCoreHost host(numberOfWorkers);
+	std::vector<Application *> applications;
+	for (int i = 0; i < numberOfInstances; ++i)
+	{
+		Application &application = host.add<Application>();
+		// A different value in each instance shows up any shared storage
+		SimuCoreContext::Scope scope(application.getContext());
+		application.testcomp.physical_input_signal.setValue(100 + i);
+		applications.push_back(&application);
+	}
+	for (int step = 0; step < numberOfSteps; ++step)
+		host.step(ticksPerStep);
+	std::vector<Application *> late_applications;
+	for (int i = 0; i < numberOfLateInstances; ++i)
+	{
+		late_applications.push_back(&host.add<Application>());
+		host.step(1);
+	}
+
+	nlohmann::json report;
+	report["ticks"] = ticksPerStep * numberOfSteps + numberOfLateInstances;
+	report["default"] = describeRegistry();
+	report["default"]["finds_output"] = SignalRegistry::getInstance().find(applications[0]->testcomp.output.getId()) != nullptr;
+	report["instances"] = nlohmann::json::array();
+	for (auto *application : applications)
+	{
+		SimuCoreContext::Scope scope(application->getContext());
+		nlohmann::json instance = describeRegistry();
+		auto &output = application->testcomp.output;
+		instance["finds_own_output"] = SignalRegistry::getInstance().find(output.getId()) == &output;
+		instance["input"] = application->testcomp.physical_input_signal.getValue();
+		report["instances"].push_back(instance);
+	}
+	report["late_ticks"] = nlohmann::json::array();
+	for (auto *application : late_applications)
+	{
+		SimuCoreContext::Scope scope(application->getContext());
+		report["late_ticks"].push_back(SignalRegistry::getInstance().getTick());
+	}
+	std::cout << report.dump() << std::endl;
+	std::exit(0);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,225 @@
+#include <SimuCore/Binding.hpp>
+#include <SimuCore/PropagationPlan.hpp>
+#include <SimuCore/SimuCoreApplication.hpp>
+#include <SimuCore/Signal.hpp>
+#include <SimuCore/generated/Config.hpp>
+#include <SimuCore/json.hpp>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace
+{
+// Two siblings with the same name get the same ID
+class SiblingCollision : public SimuCoreApplication
+{
+public:
+	SiblingCollision() : SimuCoreApplication("Sibling collision") {}
+	void bindSignals() {}
+
+	PhysicalInput<int> first{this, "Same", 1};
+	PhysicalInput<int> second{this, "Same", 2};
+};
+
+// Config parameters are not in the application tree, so only the
+// registry sees that "Config->blah" is taken
+class ConfigCollision : public SimuCoreApplication
+{
+public:
+	ConfigCollision() : SimuCoreApplication("Config") {}
+	void bindSignals() {}
+
+	PhysicalInput<int> blah{this, "blah"};
+};
+
+class Unique : public SimuCoreApplication
+{
+public:
+	Unique() : SimuCoreApplication("Unique") {}
+	void bindSignals() {}
+
+	PhysicalInput<int> first{this, "First", 1};
+	PhysicalInput<int> second{this, "Second", 2};
+};
+
+// Registers signals after initApp(), as code that builds parts of
+// the model on demand would
+class LateRegistration : public SimuCoreApplication
+{
+public:
+	LateRegistration() : SimuCoreApplication("Late registration") {}
+	void bindSignals() {}
+
+	PhysicalInput<int> early{this, "Early", 1};
+	std::unique_ptr<PhysicalInput<int>> late;
+	std::unique_ptr<PhysicalInput<int>> after_snapshots;
+};
+
+// One signal of each kind, with scalar, array and FixedString values
+class Typed : public SimuCoreApplication
+{
+public:
+	Typed() : SimuCoreApplication("Typed") {}
+	void bindSignals() {}
+
+	PhysicalInput<int> setpoint{this, "Setpoint"};
+	PhysicalInput<std::array<double, 3>> strip{this, "Strip"};
+	PhysicalOutput<FixedString<12>> status{this, "Status"};
+	Parameter<double> gain{this, "Gain", 1.0};
+	Parameter<FixedString<4>> unit{this, "Unit", "bar"};
+	InputSignal<bool> enable{this, "Enable"};
+	OutputSignal<uint16_t> counter{this, "Counter"};
+};
+
+// A feedback loop through copy and alias bindings of two types,
+// so the values depend on how and when outputs reach their inputs
+class Source : public Component
+{
+public:
+	Source(Component *parent, const std::string &name) : Component(parent, name) {}
+	void init() {}
+	void execute()
+	{
+		count.setValue(total.getValue() + 1);
+		level.setValue(level.getValue() + 0.5);
+	}
+
+	InputSignal<int> total{this, "Total"};
+	OutputSignal<int> count{this, "Count"};
+	OutputSignal<int> spare{this, "Spare"};
+	OutputSignal<double> level{this, "Level"};
+};
+
+class Sink : public Component
+{
+public:
+	Sink(Component *parent, const std::string &name) : Component(parent, name) {}
+	void init() {}
+	void execute() { sum.setValue(a.getValue() + b.getValue() + c.getValue()); }
+
+	InputSignal<int> a{this, "A"};
+	InputSignal<int> b{this, "B"};
+	InputSignal<int> c{this, "C"};
+	InputSignal<double> level{this, "Level"};
+	OutputSignal<int> sum{this, "Sum"};
+};
+
+class Propagation : public SimuCoreApplication
+{
+public:
+	Propagation() : SimuCoreApplication("Propagation") {}
+	void bindSignals()
+	{
+		ComponentBinder::bind(source.count, sink.a);
+		ComponentBinder::bind(source.count, sink.b);
+		ComponentBinder::bind(source.count, sink.c, BindingMode::Alias);
+		ComponentBinder::bind(source.level, sink.level);
+		ComponentBinder::bind(sink.sum, source.total);
+	}
+
+	Source source{this, "Source"};
+	Sink sink{this, "Sink"};
+};
+
+// What every input of Propagation reads over a few ticks, stepped
+// through the compiled plan or through the bound-input walk
+nlohmann::json propagate(Propagation &app, bool through_plan, bool double_buffered)
+{
+	SimuCore::getConfig().double_buffered_signals.setValue(double_buffered);
+	if (!through_plan)
+		PropagationPlan::getInstance().clear();
+	nlohmann::json ticks = nlohmann::json::array();
+	for (int i = 0; i < 5; ++i)
+	{
+		app.step();
+		ticks.push_back({app.source.total.getValue(), app.sink.a.getValue(), app.sink.b.getValue(),
+						 app.sink.c.getValue(), app.sink.level.getValue()});
+	}
+	return ticks;
+}
+
+// Builds App in a context of its own, initialises it and steps it once
+template <typename App, typename Check>
+nlohmann::json runApplication(Check check)
+{
+	SimuCoreContext context;
+	std::unique_ptr<App> app;
+	{
+		SimuCoreContext::Scope scope(context);
+		app = std::make_unique<App>();
+	}
+	nlohmann::json result;
+	result["started"] = app->initApp();
+	app->step();
+	SimuCoreContext::Scope scope(context);
+	result["tick"] = SignalRegistry::getInstance().getTick();
+	check(*app, result);
+	return result;
+}
+}
+
+void setup()
+{
+	nlohmann::json report;
+	report["sibling_collision"] = runApplication<SiblingCollision>([](SiblingCollision &app, nlohmann::json &result)
+																   {
+		result["first_registered"] = app.first.isRegistered();
+		result["second_registered"] = app.second.isRegistered();
+		result["found_value"] = SignalRegistry::getInstance().find(app.first.getId())->getValueAsString(); });
+	report["config_collision"] = runApplication<ConfigCollision>([](ConfigCollision &app, nlohmann::json &result)
+																 { result["registered"] = app.blah.isRegistered(); });
+	report["late_registration"] = runApplication<LateRegistration>([](LateRegistration &app, nlohmann::json &result)
+																   {
+		auto &registry = SignalRegistry::getInstance();
+		result["frozen"] = registry.isFrozen();
+		app.late = std::make_unique<PhysicalInput<int>>(&app, "Late", 2);
+		result["late_registered"] = app.late->isRegistered();
+		result["finds_late"] = registry.find(app.late->getId()) == app.late.get();
+		result["finds_early"] = registry.find(app.early.getId()) == &app.early;
+		result["finds_unknown"] = registry.find(componentIdFromPath("Late registration->Unknown")) != nullptr;
+		// Network threads read the snapshot without locking, so it cannot grow
+		registry.enableSnapshots();
+		app.after_snapshots = std::make_unique<PhysicalInput<int>>(&app, "After snapshots", 3);
+		result["after_snapshots_registered"] = app.after_snapshots->isRegistered();
+		result["finds_after_snapshots"] = registry.find(app.after_snapshots->getId()) != nullptr;
+		result["finds_late_after_snapshots"] = registry.find(app.late->getId()) == app.late.get(); });
+	report["typed"] = runApplication<Typed>([](Typed &app, nlohmann::json &result)
+											{
+		const std::string prefix = app.getName() + "->";
+		for (auto type : {ComponentType::INTERNAL_INPUT, ComponentType::INTERNAL_OUTPUT, ComponentType::PHYSICAL_INPUT,
+						  ComponentType::PHYSICAL_OUTPUT, ComponentType::PARAMETER})
+		{
+			auto &signals = result["signals"][std::to_string(static_cast<int>(type))];
+			signals = nlohmann::json::array();
+			// Config parameters are PARAMETER signals too; only this application's count here
+			for (auto *signal : SignalRegistry::getInstance().getSignalsOfType(type))
+				if (signal->getFullName().rfind(prefix, 0) == 0)
+					signals.push_back({signal->getName(), signalTypeName(signal->getType()), signal->getTypeName()});
+		} });
+	report["propagation"] = runApplication<Propagation>([](Propagation &, nlohmann::json &result)
+														{
+		const PropagationPlan &plan = PropagationPlan::getInstance();
+		result["compiled"] = plan.isCompiled();
+		result["routes"] = plan.routeCount();
+		result["destinations"] = plan.destinationCount();
+		result["dump"] = plan.dump(); });
+	for (bool double_buffered : {false, true})
+	{
+		const char *mode = double_buffered ? "double_buffered" : "direct";
+		for (bool through_plan : {true, false})
+			report["propagation"][mode][through_plan ? "plan" : "walk"] =
+				runApplication<Propagation>([&](Propagation &app, nlohmann::json &result)
+											{ result = propagate(app, through_plan, double_buffered); });
+	}
+	report["unique"] = runApplication<Unique>([](Unique &app, nlohmann::json &result)
+											  { result["registered"] = app.first.isRegistered() && app.second.isRegistered(); });
+	std::cout << report.dump() << std::endl;
+	std::exit(0);
+}
+
+void loop()
+{
+}
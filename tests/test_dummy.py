@@ -1,7 +1,428 @@
+import json
+import threading
+
+import pytest
+from pydantic import BaseModel
+from websockets.sync.client import ClientConnection, connect
+
+from simucore_pytest.core.application_tree import PhysicalInput
+from simucore_pytest.core.ids import component_id
+from simucore_pytest.core.schemas import (
+    ApplicationTreeData,
+    ForceProtocol,
+    ForceSignal,
+    GetChangesProtocol,
+    GetHistoryProtocol,
+    ReleaseProtocol,
+    UpdateInput,
+    UpdatePysicalInputsProtocol,
+)
 from simucore_pytest.core.simulation import SimuCoreSystem
 
 
 def test_dummy(simulation_instance: SimuCoreSystem) -> None:
-    simulation_instance.update_value(id=2608728740, value="123453")
+    simulation_instance.update_value(id=component_id("Custom application name", "TestComponent", "Physical input signal"), value="123453")
     simulation_instance.tick(20000)
     assert simulation_instance.get_application_info().up_time_in_milli_seconds == 200000
+
+
+def test_update_elements(simulation_instance: SimuCoreSystem) -> None:
+    strip_id = component_id("Custom application name", "TestComponent", "Temperature strip")
+    response = simulation_instance.update_elements(id=strip_id, offset=1, values=["20.5", "21.5"])
+    assert response.status == "SUCCESS"
+
+    test_component = next(c for c in simulation_instance.get_application_tree().Components if c.name == "TestComponent")
+    strip = next(s for s in test_component.PhysicalInputs or [] if s.id == strip_id)
+    assert [float(v) for v in strip.value.strip("[]").split(",")] == [0.0, 20.5, 21.5, 0.0]
+
+    # Empty elements are refused, not skipped to make up the length
+    batch = [UpdatePysicalInputsProtocol(parameters=[UpdateInput(id=strip_id, value=text)]) for text in ("[1,2,,3,4]", "[1,2,3,4,]", "[,1,2,3,4]")]
+    assert _send_batch(simulation_instance, batch) == ["FAILURE"] * 3
+    strip = next(s for s in simulation_instance.get_changes().signals if s.id == strip_id)
+    assert [float(v) for v in strip.value.strip("[]").split(",")] == [0.0, 20.5, 21.5, 0.0]
+
+    # An offset so large that offset + count wraps around is refused too
+    assert simulation_instance.update_elements(id=strip_id, offset=2**64 - 1, values=["7", "8"]).status == "FAILURE"
+    strip = next(s for s in simulation_instance.get_changes().signals if s.id == strip_id)
+    assert [float(v) for v in strip.value.strip("[]").split(",")] == [0.0, 20.5, 21.5, 0.0]
+
+
+def test_history(simulation_instance: SimuCoreSystem) -> None:
+    output_id = component_id("Custom application name", "TestComponent", "Someoutput")
+    simulation_instance.tick(10)
+
+    history = simulation_instance.get_history([output_id])
+    assert history.response.status == "SUCCESS"
+    assert history.signals[0].ticks == list(range(10))
+    values = [int(v) for v in history.signals[0].values]
+    assert all(a < b for a, b in zip(values, values[1:], strict=False))
+
+
+def test_get_changes(simulation_instance: SimuCoreSystem) -> None:
+    output_id = component_id("Custom application name", "TestComponent", "Someoutput")
+    simulation_instance.tick(1)
+    everything = simulation_instance.get_changes()
+    simulation_instance.tick(3)
+
+    changes = simulation_instance.get_changes(since=everything.tick)
+    assert changes.response.status == "SUCCESS"
+    assert changes.tick == everything.tick + 3
+    assert output_id in {s.id for s in changes.signals}
+    assert all(s.tick >= everything.tick for s in changes.signals)
+    assert len(changes.signals) < len(everything.signals)
+
+
+def test_float_round_trip(simulation_instance: SimuCoreSystem) -> None:
+    """Values must convert the same whatever the locale. Run with a comma
+    decimal LC_NUMERIC (e.g. de_DE.UTF-8), ideally against native_locale."""
+    strip_id = component_id("Custom application name", "TestComponent", "Temperature strip")
+    values = [0.1, -2.5e-300, 123456.789, 1 / 3]
+    response = simulation_instance.update_elements(id=strip_id, offset=0, values=[repr(v) for v in values])
+    assert response.status == "SUCCESS"
+
+    strip = next(s for s in simulation_instance.get_changes().signals if s.id == strip_id)
+    assert [float(v) for v in strip.value.strip("[]").split(",")] == values
+
+
+@pytest.mark.parametrize(("text", "status"), [("+5", "SUCCESS"), ("+.5", "SUCCESS"), ("+-5", "FAILURE"), ("+ 5", "FAILURE"), ("+", "FAILURE")])
+def test_leading_plus(simulation_instance: SimuCoreSystem, text: str, status: str) -> None:
+    """A '+' is only accepted in front of a number."""
+    strip_id = component_id("Custom application name", "TestComponent", "Temperature strip")
+    assert simulation_instance.update_elements(id=strip_id, offset=0, values=[text]).status == status
+
+
+def test_bus(simulation_instance: SimuCoreSystem) -> None:
+    simulation_instance.tick(3)
+
+    test_component = next(c for c in simulation_instance.get_application_tree().Components if c.name == "TestComponent")
+    receiver = next(c for c in test_component.Components or [] if c.name == "TestComponent2")
+    bus = next(s for s in receiver.Inputs or [] if s.name == "Drive")
+    assert bus.typeName == "bus"
+
+    fields = {f.name: f for f in bus.Inputs or []}
+    assert set(fields) == {"speed", "torque", "mode"}
+    assert fields["speed"].id == component_id("Custom application name", "TestComponent", "TestComponent2", "Drive", "speed")
+    assert float(fields["speed"].value) > 0
+    assert float(fields["torque"].value) == 2 * float(fields["speed"].value)
+    assert fields["mode"].value == "1"
+
+
+def test_alias_binding(simulation_instance: SimuCoreSystem) -> None:
+    """An aliased input reads its output in place, changes with it and cannot be forced."""
+    output_id = component_id("Custom application name", "TestComponent", "Setting")
+    input_id = component_id("Custom application name", "TestComponent", "TestComponent2", "Setting")
+    physical_id = component_id("Custom application name", "TestComponent", "Physical input signal")
+
+    simulation_instance.update_value(id=physical_id, value="77")
+    simulation_instance.tick(2)
+    changes = {s.id: s for s in simulation_instance.get_changes().signals}
+    assert changes[input_id].value == "77"
+    assert changes[input_id].tick == changes[output_id].tick
+
+    # No change bit on the input while its output keeps its value
+    since = simulation_instance.get_changes().tick
+    simulation_instance.tick(3)
+    assert not {output_id, input_id} & {s.id for s in simulation_instance.get_changes(since=since).signals}
+
+    simulation_instance.update_value(id=physical_id, value="78")
+    simulation_instance.tick(1)
+    changes = {s.id: s for s in simulation_instance.get_changes(since=since).signals}
+    assert changes[input_id].value == "78"
+    assert changes[input_id].tick == changes[output_id].tick
+
+    assert simulation_instance.force({input_id: "5"}).status == "FAILURE"
+    assert simulation_instance.force({output_id: "5"}).status == "SUCCESS"
+    simulation_instance.tick(1)
+    changes = {s.id: s for s in simulation_instance.get_changes().signals}
+    assert changes[input_id].value == "5"
+
+
+def test_derived_signal(simulation_instance: SimuCoreSystem) -> None:
+    output_id = component_id("Custom application name", "TestComponent", "Someoutput")
+    doubled_id = component_id("Custom application name", "TestComponent", "Doubled output")
+    simulation_instance.tick(5)
+
+    history = simulation_instance.get_history([output_id, doubled_id])
+    assert history.response.status == "SUCCESS"
+    outputs, doubled = history.signals
+    assert doubled.ticks == outputs.ticks
+    assert [float(v) for v in doubled.values] == [2 * int(v) for v in outputs.values]
+
+
+def test_unread_derived_signal(simulation_instance: SimuCoreSystem) -> None:
+    """A derived signal without bound inputs or history is not computed each tick, only when a client reads it."""
+    output_id = component_id("Custom application name", "TestComponent", "Someoutput")
+    tripled_id = component_id("Custom application name", "TestComponent", "Tripled output")
+    evaluations_id = component_id("Custom application name", "TestComponent", "Tripled evaluations")
+
+    for evaluations in (1, 2):
+        simulation_instance.tick(10)
+        values = {s.id: s.value for s in simulation_instance.get_changes().signals}
+        assert int(values[evaluations_id]) == evaluations
+        assert int(values[tripled_id]) == 3 * int(values[output_id])
+
+    # Nothing changed since, so reading it again does not compute it again
+    values = {s.id: s.value for s in simulation_instance.get_changes().signals}
+    assert int(values[evaluations_id]) == 2
+
+
+def test_double_buffered(simulation_instance: SimuCoreSystem) -> None:
+    """Double-buffered, every input reads the previous tick's value whichever component runs first."""
+    output_id = component_id("Custom application name", "TestComponent", "Someoutput")
+    echo_id = component_id("Custom application name", "TestComponent", "TestComponent2", "Echo")
+    copy_id = component_id("Custom application name", "TestComponent", "Echo copy")
+    written_id = component_id("Custom application name", "TestComponent", "Written output")
+    simulation_instance.update_value(id=component_id("Config", "double_buffered_signals"), value="true")
+    simulation_instance.tick(10)
+
+    history = simulation_instance.get_history([output_id, echo_id, copy_id, written_id])
+    outputs, echoes, copies, written = ([int(v) for v in signal.values] for signal in history.signals)
+    # Each tick's history holds what that tick committed
+    assert outputs == written
+    # The echo's component runs after the output's, the copy's before the echo's
+    assert echoes[1:] == outputs[:-1]
+    assert copies[1:] == echoes[:-1]
+
+    # So does the snapshot, stamped with the tick that committed it
+    changes = {s.id: s for s in simulation_instance.get_changes().signals}
+    for signal, values in zip(history.signals[:3], (outputs, echoes, copies), strict=True):
+        assert int(changes[signal.id].value) == values[-1]
+        assert changes[signal.id].tick == signal.ticks[-1]
+
+
+def test_fixed_point(simulation_instance: SimuCoreSystem) -> None:
+    gain_id = component_id("Custom application name", "TestComponent", "Gain")
+
+    def gain() -> PhysicalInput:
+        test_component = next(c for c in simulation_instance.get_application_tree().Components if c.name == "TestComponent")
+        return next(s for s in test_component.PhysicalInputs or [] if s.id == gain_id)
+
+    assert gain().typeName == "Q15"
+    assert gain().value == "0.5"
+    simulation_instance.update_value(id=gain_id, value="-0.25")
+    assert gain().value == "-0.25"
+    # Saturates to the largest Q15 value
+    simulation_instance.update_value(id=gain_id, value="3")
+    assert float(gain().value) == pytest.approx(1 - 2**-15, abs=2**-16)
+
+
+def test_fixed_string(simulation_instance: SimuCoreSystem) -> None:
+    """Text longer than a FixedString signal's capacity is refused, not cut."""
+    label_id = component_id("Custom application name", "TestComponent", "Label")
+    assert next(s.value for s in simulation_instance.get_changes().signals if s.id == label_id) == "start"
+    batch = [
+        UpdatePysicalInputsProtocol(parameters=[UpdateInput(id=label_id, value="12345678")]),
+        UpdatePysicalInputsProtocol(parameters=[UpdateInput(id=label_id, value="123456789")]),
+    ]
+    assert _send_batch(simulation_instance, batch) == ["SUCCESS", "FAILURE"]
+    value = next(s.value for s in simulation_instance.get_changes().signals if s.id == label_id)
+    assert value == "12345678"
+
+
+def test_long_string(simulation_instance: SimuCoreSystem) -> None:
+    """A std::string longer than its snapshot slot is cut in replies, and marked truncated."""
+    description_id = component_id("Custom application name", "TestComponent", "Description")
+
+    def description() -> tuple:
+        change = next(s for s in simulation_instance.get_changes().signals if s.id == description_id)
+        tree = simulation_instance.get_application_tree()
+        component = next(c for c in tree.Components if c.name == "TestComponent")
+        signal = next(s for s in component.PhysicalInputs if s.id == description_id)
+        return change.value, change.truncated, signal.value, signal.truncated
+
+    assert description() == ("short", False, "short", False)
+    text = "".join(chr(ord("a") + i % 26) for i in range(300))
+    simulation_instance.update_value(id=description_id, value=text)
+    simulation_instance.tick(1)
+    assert description() == (text[:255], True, text[:255], True)
+    simulation_instance.update_value(id=description_id, value=text[:255])
+    simulation_instance.tick(1)
+    assert description() == (text[:255], False, text[:255], False)
+
+
+def test_deadband(simulation_instance: SimuCoreSystem) -> None:
+    """A change within the deadband is neither reported nor stamped; a larger one is both."""
+    pressure_id = component_id("Custom application name", "TestComponent", "Pressure")
+    simulation_instance.tick(1)
+    since = simulation_instance.get_changes().tick
+
+    simulation_instance.update_value(id=pressure_id, value="1.3")
+    simulation_instance.tick(1)
+    assert pressure_id not in {s.id for s in simulation_instance.get_changes(since=since).signals}
+    pressure = next(s for s in simulation_instance.get_changes().signals if s.id == pressure_id)
+    assert pressure.tick < since
+
+    simulation_instance.update_value(id=pressure_id, value="1.6")
+    simulation_instance.tick(1)
+    pressure = next(s for s in simulation_instance.get_changes(since=since).signals if s.id == pressure_id)
+    assert float(pressure.value) == 1.6
+    assert pressure.tick >= since
+
+
+def test_force(simulation_instance: SimuCoreSystem) -> None:
+    output_id = component_id("Custom application name", "TestComponent", "Someoutput")
+    input_id = component_id("Custom application name", "TestComponent", "TestComponent2", "Some input")
+
+    def value(signal_id: int) -> int:
+        return int(next(s.value for s in simulation_instance.get_changes().signals if s.id == signal_id))
+
+    # Internal outputs are read-only for UPDATE_PHYSICAL_INPUT, but can be forced
+    assert simulation_instance.force({output_id: "-7"}).status == "SUCCESS"
+    simulation_instance.tick(5)
+    assert value(output_id) == -7
+    assert value(input_id) == -7
+
+    assert simulation_instance.release([output_id]).status == "SUCCESS"
+    simulation_instance.tick(2)
+    assert value(output_id) > 0
+
+    # Released automatically after the given number of ticks
+    simulation_instance.force({output_id: "-1"}, ticks=3)
+    simulation_instance.tick(3)
+    assert value(output_id) == -1
+    simulation_instance.tick(1)
+    assert value(output_id) > 0
+
+    assert simulation_instance.force({output_id: "not a number"}).status == "FAILURE"
+
+
+def test_force_update_release_batch(simulation_instance: SimuCoreSystem) -> None:
+    """Writes queued together apply in order; an update never skips a force."""
+    input_id = component_id("Custom application name", "TestComponent", "Physical input signal")
+    batch = [
+        ForceProtocol(signals=[ForceSignal(id=input_id, value="5")]),
+        UpdatePysicalInputsProtocol(parameters=[UpdateInput(id=input_id, value="7")]),
+        ReleaseProtocol(ids=[input_id]),
+    ]
+    assert _send_batch(simulation_instance, batch) == ["SUCCESS", "FAILURE", "SUCCESS"]
+    value = next(s.value for s in simulation_instance.get_changes().signals if s.id == input_id)
+    assert int(value) == 5
+
+
+def test_invalid_update_keeps_valid_one(simulation_instance: SimuCoreSystem) -> None:
+    """An invalid update does not cancel an earlier valid one in the same batch."""
+    input_id = component_id("Custom application name", "TestComponent", "Physical input signal")
+    batch = [
+        UpdatePysicalInputsProtocol(parameters=[UpdateInput(id=input_id, value="41")]),
+        UpdatePysicalInputsProtocol(parameters=[UpdateInput(id=input_id, value="abc")]),
+    ]
+    assert _send_batch(simulation_instance, batch) == ["SUCCESS", "FAILURE"]
+    value = next(s.value for s in simulation_instance.get_changes().signals if s.id == input_id)
+    assert int(value) == 41
+
+
+def _send_batch(simulation_instance: SimuCoreSystem, batch: list[BaseModel]) -> list[str]:
+    """Sends the messages without waiting, so the tick thread takes them as one batch, and returns their statuses."""
+    with connect(simulation_instance.uri) as ws:
+        ws.recv()  # application tree sent on connect
+        for message in batch:
+            ws.send(message.model_dump_json())
+        statuses = []
+        while len(statuses) < len(batch):
+            reply = json.loads(ws.recv())
+            if isinstance(reply, dict) and "status" in reply:
+                statuses.append(reply["status"])
+    return statuses
+
+
+def test_reset(simulation_instance: SimuCoreSystem) -> None:
+    input_id = component_id("Custom application name", "TestComponent", "Physical input signal")
+
+    def value() -> int:
+        return int(next(s.value for s in simulation_instance.get_changes().signals if s.id == input_id))
+
+    simulation_instance.update_value(id=input_id, value="42")
+    simulation_instance.tick(3)
+    assert value() == 42
+
+    # Restarting restores every signal to its state before the first tick
+    simulation_instance.start()
+    assert value() == 2
+    assert simulation_instance.get_application_info().up_time_in_milli_seconds == 0
+
+
+def test_resolve(simulation_instance: SimuCoreSystem) -> None:
+    root = "Custom application name"
+    resolved = simulation_instance.resolve([f"{root}->TestComponent->Someoutput"])
+    assert resolved.response.status == "SUCCESS"
+    assert [c.id for c in resolved.components] == [component_id(root, "TestComponent", "Someoutput")]
+
+    resolved = simulation_instance.resolve([f"{root}->TestComponent->Output*"])
+    assert {c.path for c in resolved.components} == {f"{root}->TestComponent->OutputDouble"}
+
+    # The whole bus subtree, fields included
+    resolved = simulation_instance.resolve([f"{root}->**->Drive->*"])
+    assert {c.path.split("->")[-1] for c in resolved.components} == {"speed", "torque", "mode"}
+
+    # Depth first, siblings sorted by name rather than in the order they were added
+    resolved = simulation_instance.resolve([f"{root}->TestComponent->Drive->*"])
+    assert [c.path.split("->")[-1] for c in resolved.components] == ["mode", "speed", "torque"]
+    resolved = simulation_instance.resolve([f"{root}->TestComponent->**"])
+    paths = [c.path for c in resolved.components]
+    assert paths[0] == f"{root}->TestComponent"
+    assert paths.index(f"{root}->TestComponent->Drive->torque") + 1 == paths.index(f"{root}->TestComponent->Echo copy")
+    children = [p.removeprefix(f"{root}->TestComponent->") for p in paths if p.count("->") == 2]
+    assert children == sorted(children)
+
+    resolved = simulation_instance.resolve([f"{root}->Missing"])
+    assert resolved.response.status == "WARNING"
+    assert resolved.components == []
+
+
+def _request(ws: ClientConnection, message: BaseModel, key: str) -> dict:
+    ws.send(message.model_dump_json())
+    while True:
+        reply = json.loads(ws.recv())
+        # Tick completion is broadcast to every client; skip it
+        if isinstance(reply, dict) and key in reply:
+            return reply
+
+
+@pytest.mark.parametrize("double_buffered", [False, True])
+def test_concurrent_clients(simulation_instance: SimuCoreSystem, double_buffered: bool) -> None:
+    """Several clients read and write while the tick loop runs. Run against
+    the native_tsan environment to have ThreadSanitizer check for races."""
+    input_id = component_id("Custom application name", "TestComponent", "Physical input signal")
+    output_id = component_id("Custom application name", "TestComponent", "Someoutput")
+    written_id = component_id("Custom application name", "TestComponent", "Written output")
+    simulation_instance.update_value(id=component_id("Config", "double_buffered_signals"), value=str(double_buffered).lower())
+    errors: list[Exception] = []
+
+    def read_while_ticking() -> None:
+        try:
+            with connect(simulation_instance.uri) as ws:
+                ws.recv()  # application tree sent on connect
+                since = 0
+                for _ in range(50):
+                    changes = _request(ws, GetChangesProtocol(since=since), "tick")
+                    assert changes["tick"] >= since
+                    # Both are set to the same value each tick, so one snapshot shows them equal
+                    values = {s["id"]: s["value"] for s in changes["signals"]}
+                    if output_id in values and written_id in values:
+                        assert values[output_id] == values[written_id]
+                    since = changes["tick"]
+                    _request(ws, ApplicationTreeData(), "id")
+                    history = _request(ws, GetHistoryProtocol(ids=[output_id]), "signals")
+                    ticks = history["signals"][0]["ticks"]
+                    assert ticks == sorted(ticks)
+        except Exception as error:
+            errors.append(error)
+
+    def write_while_ticking() -> None:
+        try:
+            with connect(simulation_instance.uri) as ws:
+                ws.recv()
+                for value in range(50):
+                    update = UpdatePysicalInputsProtocol(parameters=[UpdateInput(id=input_id, value=str(value))])
+                    assert _request(ws, update, "status")["status"] == "SUCCESS"
+        except Exception as error:
+            errors.append(error)
+
+    clients = [threading.Thread(target=read_while_ticking) for _ in range(4)]
+    clients += [threading.Thread(target=write_while_ticking) for _ in range(2)]
+    for client in clients:
+        client.start()
+    simulation_instance.tick(5000)
+    for client in clients:
+        client.join()
+    assert not errors
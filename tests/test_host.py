@@ -0,0 +1,36 @@
+import json
+import subprocess
+from pathlib import Path
+
+from platformio.public import load_build_metadata
+from platformio.run.cli import cli as run_cli
+
+HOST_PROJECT = Path(__file__).parent / "host_project"
+
+
+def test_host_instances_stay_separate() -> None:
+    """Several applications stepped on one SimuCoreHost keep their own ticks and registries."""
+    run_cli(["-d", HOST_PROJECT, "-e", "native"], standalone_mode=False)
+    meta = load_build_metadata(HOST_PROJECT, ["native"])
+    assert meta
+    output = subprocess.run([meta["native"]["prog_path"]], capture_output=True, text=True, check=True, timeout=60).stdout
+    report = json.loads(output.splitlines()[-1])
+
+    instances = report["instances"]
+    assert len(instances) > 1
+    assert all(instance["tick"] == report["ticks"] for instance in instances)
+    assert all(instance["finds_own_output"] for instance in instances)
+    # Each instance was given its own input value before stepping
+    assert [instance["input"] for instance in instances] == list(range(100, 100 + len(instances)))
+    # Instances added between steps are stepped once per step from then on
+    late_ticks = report["late_ticks"]
+    assert late_ticks == list(range(len(late_ticks), 0, -1))
+    # Every registry holds one application, not the signals of all of them
+    assert len({instance["signals"] for instance in instances}) == 1
+
+    # The default context is never stepped and holds no application signals
+    default = report["default"]
+    assert default["tick"] == 0
+    assert not default["finds_output"]
+    assert default["signals"] < instances[0]["signals"]
+    assert len({default["registry"]} | {instance["registry"] for instance in instances}) == len(instances) + 1
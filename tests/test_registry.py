@@ -0,0 +1,87 @@
+import json
+import subprocess
+from pathlib import Path
+
+import pytest
+from platformio.public import load_build_metadata
+from platformio.run.cli import cli as run_cli
+
+REGISTRY_PROJECT = Path(__file__).parent / "registry_project"
+
+
+@pytest.fixture(scope="module")
+def report() -> dict:
+    run_cli(["-d", REGISTRY_PROJECT, "-e", "native"], standalone_mode=False)
+    meta = load_build_metadata(REGISTRY_PROJECT, ["native"])
+    assert meta
+    output = subprocess.run([meta["native"]["prog_path"]], capture_output=True, text=True, check=True, timeout=60).stdout
+    return json.loads(output.splitlines()[-1])
+
+
+def test_id_collision_is_rejected(report: dict) -> None:
+    """A signal whose ID is taken is not registered and the application does not start."""
+    sibling = report["sibling_collision"]
+    assert not sibling["started"]
+    assert sibling["tick"] == 0
+    assert sibling["first_registered"]
+    assert not sibling["second_registered"]
+    # The ID still leads to the signal that took it first
+    assert sibling["found_value"] == "1"
+
+    # Config parameters are checked although they are not in the application tree
+    config = report["config_collision"]
+    assert not config["started"]
+    assert config["tick"] == 0
+    assert not config["registered"]
+
+    unique = report["unique"]
+    assert unique["started"]
+    assert unique["tick"] == 1
+    assert unique["registered"]
+
+
+def test_late_registration(report: dict) -> None:
+    """A signal registered after initApp() is found through the rebuilt ID index, until snapshots are enabled."""
+    late = report["late_registration"]
+    assert late["started"]
+    assert late["frozen"]
+    assert late["late_registered"]
+    assert late["finds_late"]
+    assert late["finds_early"]
+    assert not late["finds_unknown"]
+
+    assert not late["after_snapshots_registered"]
+    assert not late["finds_after_snapshots"]
+    assert late["finds_late_after_snapshots"]
+
+
+def test_propagation_plan(report: dict) -> None:
+    """The compiled plan holds a route per output and propagates as walking the bound inputs does."""
+    propagation = report["propagation"]
+    assert propagation["compiled"]
+    # Every output has a route, bound or not, so a commit covers them all
+    assert propagation["routes"] == 4
+    assert propagation["destinations"] == 5
+    assert propagation["dump"].splitlines() == [
+        "int32 Propagation->Source->Count -> Propagation->Sink->A, Propagation->Sink->B (alias Propagation->Sink->C)",
+        "int32 Propagation->Source->Spare ->",
+        "int32 Propagation->Sink->Sum -> Propagation->Source->Total",
+        "double Propagation->Source->Level -> Propagation->Sink->Level",
+    ]
+
+    for mode in ("direct", "double_buffered"):
+        assert propagation[mode]["plan"] == propagation[mode]["walk"]
+    # The loop does go round, and double buffering delays it
+    assert propagation["direct"]["plan"][-1][0] > 0
+    assert propagation["direct"]["plan"] != propagation["double_buffered"]["plan"]
+
+
+def test_signals_of_type(report: dict) -> None:
+    """getSignalsOfType() lists each kind of signal in registration order, with its value type's tag and name."""
+    # Keyed by ComponentType: INTERNAL_INPUT, INTERNAL_OUTPUT, PHYSICAL_INPUT, PHYSICAL_OUTPUT, PARAMETER
+    signals = report["typed"]["signals"]
+    assert signals["0"] == [["Enable", "bool", "bool"]]
+    assert signals["1"] == [["Counter", "uint16", "uint16"]]
+    assert signals["2"] == [["Setpoint", "int32", "int32"], ["Strip", "array", "double[3]"]]
+    assert signals["3"] == [["Status", "FixedString", "FixedString<12>"]]
+    assert signals["4"] == [["Gain", "double", "double"], ["Unit", "FixedString", "FixedString<4>"]]